@@ -2,6 +2,8 @@
 
 package api
 
+import "hash/fnv"
+
 const (
 	// ServiceName is the systemd name
 	ServiceName = "carnx"
@@ -22,6 +24,44 @@ const (
 	// XDPFlagsHwMode is the hardware offload mode. The kernel code is re-verified and compiled
 	// to be run by the hardware firmware
 	XDPFlagsHwMode = uint(4)
+
+	// FeaturePkt enables the PKT counter (always enabled)
+	FeaturePkt = uint(1)
+	// FeatureL2 enables the counters based on the ethernet type (IP, IP6, ARP)
+	FeatureL2 = uint(2)
+	// FeatureL3 enables the counters based on the ip protocol (TCP, UDP, ICMP, ICMP6)
+	FeatureL3 = uint(4)
+	// FeatureL4 enables the counters based on the tcp flags (ACK, SYN)
+	FeatureL4 = uint(8)
+	// FeatureL7 enables the app-layer counters (DNS_*, HTTP_*, TLS*)
+	FeatureL7 = uint(16)
+	// FeatureSni enables the table of the hashed TLS server names
+	FeatureSni = uint(32)
+	// FeatureRates enables the packet and bit rate estimators
+	FeatureRates = uint(64)
+	// FeatureDefault is the set of groups enabled when none is given
+	FeatureDefault = FeaturePkt | FeatureL2 | FeatureL3 | FeatureL4 | FeatureRates
+	// FeatureAll enables all the counters
+	FeatureAll = FeatureDefault | FeatureL7 | FeatureSni
+
+	// StageL3 is the slot of the parser pipeline processing the ip header
+	StageL3 = uint(0)
+	// StageL4 is the slot of the parser pipeline processing the tcp/udp header
+	StageL4 = uint(1)
+	// StageApp is the slot of the optional app-layer analyzer
+	StageApp = uint(2)
 )
 
+// SniHash returns the hash of a server name as computed by the kernel
+// program (FNV-1a over its first 64 bytes). It allows to match the
+// entries returned by GetSniTop with known names
+func SniHash(name string) uint32 {
+	if len(name) > 64 {
+		name = name[:64]
+	}
+	h := fnv.New32a()
+	h.Write([]byte(name))
+	return h.Sum32()
+}
+
 func main() {}
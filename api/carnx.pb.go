@@ -396,32 +396,1128 @@ func (x *Snap) GetData() map[string]uint64 {
 	return nil
 }
 
+type StreamParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	PeriodMs uint32 `protobuf:"varint,1,opt,name=period_ms,json=periodMs,proto3" json:"period_ms,omitempty"` // Period between two messages (0: 1000)
+}
+
+func (x *StreamParameters) Reset() {
+	*x = StreamParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[8]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *StreamParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*StreamParameters) ProtoMessage() {}
+
+func (x *StreamParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[8]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use StreamParameters.ProtoReflect.Descriptor instead.
+func (*StreamParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{8}
+}
+
+func (x *StreamParameters) GetPeriodMs() uint32 {
+	if x != nil {
+		return x.PeriodMs
+	}
+	return 0
+}
+
+type SourceSnap struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Source string            `protobuf:"bytes,1,opt,name=source,proto3" json:"source,omitempty"`                                                                                      // Label of the upstream
+	Up     bool              `protobuf:"varint,2,opt,name=up,proto3" json:"up,omitempty"`                                                                                             // The stream with the upstream is open
+	Error  string            `protobuf:"bytes,3,opt,name=error,proto3" json:"error,omitempty"`                                                                                        // Last error (when the upstream is down)
+	Data   map[string]uint64 `protobuf:"bytes,4,rep,name=data,proto3" json:"data,omitempty" protobuf_key:"bytes,1,opt,name=key,proto3" protobuf_val:"varint,2,opt,name=value,proto3"` // Last snapshot received from the upstream
+	Stale  bool              `protobuf:"varint,5,opt,name=stale,proto3" json:"stale,omitempty"`                                                                                       // The upstream is down, data is its last snapshot
+}
+
+func (x *SourceSnap) Reset() {
+	*x = SourceSnap{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[9]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *SourceSnap) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*SourceSnap) ProtoMessage() {}
+
+func (x *SourceSnap) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[9]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use SourceSnap.ProtoReflect.Descriptor instead.
+func (*SourceSnap) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{9}
+}
+
+func (x *SourceSnap) GetSource() string {
+	if x != nil {
+		return x.Source
+	}
+	return ""
+}
+
+func (x *SourceSnap) GetUp() bool {
+	if x != nil {
+		return x.Up
+	}
+	return false
+}
+
+func (x *SourceSnap) GetError() string {
+	if x != nil {
+		return x.Error
+	}
+	return ""
+}
+
+func (x *SourceSnap) GetData() map[string]uint64 {
+	if x != nil {
+		return x.Data
+	}
+	return nil
+}
+
+func (x *SourceSnap) GetStale() bool {
+	if x != nil {
+		return x.Stale
+	}
+	return false
+}
+
+type MergedSnap struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Time    uint64            `protobuf:"varint,1,opt,name=time,proto3" json:"time,omitempty"`                                                                                           // Time of the merge (ns since epoch)
+	Sources []*SourceSnap     `protobuf:"bytes,2,rep,name=sources,proto3" json:"sources,omitempty"`                                                                                      // Latest snapshot of each upstream
+	Total   map[string]uint64 `protobuf:"bytes,3,rep,name=total,proto3" json:"total,omitempty" protobuf_key:"bytes,1,opt,name=key,proto3" protobuf_val:"varint,2,opt,name=value,proto3"` // Sum of the last counters of the upstreams
+}
+
+func (x *MergedSnap) Reset() {
+	*x = MergedSnap{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[10]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *MergedSnap) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*MergedSnap) ProtoMessage() {}
+
+func (x *MergedSnap) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[10]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use MergedSnap.ProtoReflect.Descriptor instead.
+func (*MergedSnap) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{10}
+}
+
+func (x *MergedSnap) GetTime() uint64 {
+	if x != nil {
+		return x.Time
+	}
+	return 0
+}
+
+func (x *MergedSnap) GetSources() []*SourceSnap {
+	if x != nil {
+		return x.Sources
+	}
+	return nil
+}
+
+func (x *MergedSnap) GetTotal() map[string]uint64 {
+	if x != nil {
+		return x.Total
+	}
+	return nil
+}
+
+type SniTopParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	K uint32 `protobuf:"varint,1,opt,name=k,proto3" json:"k,omitempty"` // Number of server names to return (0: 10)
+}
+
+func (x *SniTopParameters) Reset() {
+	*x = SniTopParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[11]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *SniTopParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*SniTopParameters) ProtoMessage() {}
+
+func (x *SniTopParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[11]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use SniTopParameters.ProtoReflect.Descriptor instead.
+func (*SniTopParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{11}
+}
+
+func (x *SniTopParameters) GetK() uint32 {
+	if x != nil {
+		return x.K
+	}
+	return 0
+}
+
+type SniCount struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Hash  uint32 `protobuf:"varint,1,opt,name=hash,proto3" json:"hash,omitempty"`   // FNV-1a hash of the server name (see api.SniHash)
+	Count uint64 `protobuf:"varint,2,opt,name=count,proto3" json:"count,omitempty"` // Number of TLS ClientHello
+}
+
+func (x *SniCount) Reset() {
+	*x = SniCount{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[12]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *SniCount) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*SniCount) ProtoMessage() {}
+
+func (x *SniCount) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[12]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use SniCount.ProtoReflect.Descriptor instead.
+func (*SniCount) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{12}
+}
+
+func (x *SniCount) GetHash() uint32 {
+	if x != nil {
+		return x.Hash
+	}
+	return 0
+}
+
+func (x *SniCount) GetCount() uint64 {
+	if x != nil {
+		return x.Count
+	}
+	return 0
+}
+
+type SniTop struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Entries []*SniCount `protobuf:"bytes,1,rep,name=entries,proto3" json:"entries,omitempty"` // Most seen server names (decreasing count)
+}
+
+func (x *SniTop) Reset() {
+	*x = SniTop{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[13]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *SniTop) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*SniTop) ProtoMessage() {}
+
+func (x *SniTop) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[13]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use SniTop.ProtoReflect.Descriptor instead.
+func (*SniTop) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{13}
+}
+
+func (x *SniTop) GetEntries() []*SniCount {
+	if x != nil {
+		return x.Entries
+	}
+	return nil
+}
+
+type SampleParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Rate uint32 `protobuf:"varint,1,opt,name=rate,proto3" json:"rate,omitempty"` // 1 packet out of rate is exported (0: 1000)
+}
+
+func (x *SampleParameters) Reset() {
+	*x = SampleParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[14]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *SampleParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*SampleParameters) ProtoMessage() {}
+
+func (x *SampleParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[14]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use SampleParameters.ProtoReflect.Descriptor instead.
+func (*SampleParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{14}
+}
+
+func (x *SampleParameters) GetRate() uint32 {
+	if x != nil {
+		return x.Rate
+	}
+	return 0
+}
+
+type Sample struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Timestamp uint64 `protobuf:"varint,1,opt,name=timestamp,proto3" json:"timestamp,omitempty"`            // Reception time (ns since epoch)
+	Ifindex   uint32 `protobuf:"varint,2,opt,name=ifindex,proto3" json:"ifindex,omitempty"`                // Ingress interface
+	Cpu       uint32 `protobuf:"varint,3,opt,name=cpu,proto3" json:"cpu,omitempty"`                        // CPU which processed the packet
+	Length    uint32 `protobuf:"varint,4,opt,name=length,proto3" json:"length,omitempty"`                  // Length of the packet
+	L3Proto   uint32 `protobuf:"varint,5,opt,name=l3_proto,json=l3Proto,proto3" json:"l3_proto,omitempty"` // Ethernet type
+	L4Proto   uint32 `protobuf:"varint,6,opt,name=l4_proto,json=l4Proto,proto3" json:"l4_proto,omitempty"` // IP protocol (0 if not IPv4)
+	Data      []byte `protobuf:"bytes,7,opt,name=data,proto3" json:"data,omitempty"`                       // First bytes of the packet
+	Dropped   uint64 `protobuf:"varint,8,opt,name=dropped,proto3" json:"dropped,omitempty"`                // Number of samples lost so far
+}
+
+func (x *Sample) Reset() {
+	*x = Sample{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[15]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *Sample) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*Sample) ProtoMessage() {}
+
+func (x *Sample) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[15]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use Sample.ProtoReflect.Descriptor instead.
+func (*Sample) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{15}
+}
+
+func (x *Sample) GetTimestamp() uint64 {
+	if x != nil {
+		return x.Timestamp
+	}
+	return 0
+}
+
+func (x *Sample) GetIfindex() uint32 {
+	if x != nil {
+		return x.Ifindex
+	}
+	return 0
+}
+
+func (x *Sample) GetCpu() uint32 {
+	if x != nil {
+		return x.Cpu
+	}
+	return 0
+}
+
+func (x *Sample) GetLength() uint32 {
+	if x != nil {
+		return x.Length
+	}
+	return 0
+}
+
+func (x *Sample) GetL3Proto() uint32 {
+	if x != nil {
+		return x.L3Proto
+	}
+	return 0
+}
+
+func (x *Sample) GetL4Proto() uint32 {
+	if x != nil {
+		return x.L4Proto
+	}
+	return 0
+}
+
+func (x *Sample) GetData() []byte {
+	if x != nil {
+		return x.Data
+	}
+	return nil
+}
+
+func (x *Sample) GetDropped() uint64 {
+	if x != nil {
+		return x.Dropped
+	}
+	return 0
+}
+
+type CounterInfo struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Id     uint32 `protobuf:"varint,1,opt,name=id,proto3" json:"id,omitempty"`         // Key of the counter
+	Name   string `protobuf:"bytes,2,opt,name=name,proto3" json:"name,omitempty"`      // Name of the counter
+	Group  uint32 `protobuf:"varint,3,opt,name=group,proto3" json:"group,omitempty"`   // Counter group (see --features)
+	Type   string `protobuf:"bytes,4,opt,name=type,proto3" json:"type,omitempty"`      // Kind of value (counter: monotonic total)
+	Unit   string `protobuf:"bytes,5,opt,name=unit,proto3" json:"unit,omitempty"`      // What is counted
+	Active bool   `protobuf:"varint,6,opt,name=active,proto3" json:"active,omitempty"` // The group is enabled in the loaded program
+}
+
+func (x *CounterInfo) Reset() {
+	*x = CounterInfo{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[16]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *CounterInfo) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*CounterInfo) ProtoMessage() {}
+
+func (x *CounterInfo) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[16]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use CounterInfo.ProtoReflect.Descriptor instead.
+func (*CounterInfo) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{16}
+}
+
+func (x *CounterInfo) GetId() uint32 {
+	if x != nil {
+		return x.Id
+	}
+	return 0
+}
+
+func (x *CounterInfo) GetName() string {
+	if x != nil {
+		return x.Name
+	}
+	return ""
+}
+
+func (x *CounterInfo) GetGroup() uint32 {
+	if x != nil {
+		return x.Group
+	}
+	return 0
+}
+
+func (x *CounterInfo) GetType() string {
+	if x != nil {
+		return x.Type
+	}
+	return ""
+}
+
+func (x *CounterInfo) GetUnit() string {
+	if x != nil {
+		return x.Unit
+	}
+	return ""
+}
+
+func (x *CounterInfo) GetActive() bool {
+	if x != nil {
+		return x.Active
+	}
+	return false
+}
+
+type Schema struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Hash     uint32         `protobuf:"varint,1,opt,name=hash,proto3" json:"hash,omitempty"`        // Identifier of the counter schema
+	Counters []*CounterInfo `protobuf:"bytes,2,rep,name=counters,proto3" json:"counters,omitempty"` // All the counters (index: key)
+}
+
+func (x *Schema) Reset() {
+	*x = Schema{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[17]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *Schema) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*Schema) ProtoMessage() {}
+
+func (x *Schema) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[17]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use Schema.ProtoReflect.Descriptor instead.
+func (*Schema) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{17}
+}
+
+func (x *Schema) GetHash() uint32 {
+	if x != nil {
+		return x.Hash
+	}
+	return 0
+}
+
+func (x *Schema) GetCounters() []*CounterInfo {
+	if x != nil {
+		return x.Counters
+	}
+	return nil
+}
+
+type Rates struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Time  uint64 `protobuf:"varint,1,opt,name=time,proto3" json:"time,omitempty"`                // Timestamp (ns since epoch)
+	RxPps uint64 `protobuf:"varint,2,opt,name=rx_pps,json=rxPps,proto3" json:"rx_pps,omitempty"` // Incoming packets per second
+	RxBps uint64 `protobuf:"varint,3,opt,name=rx_bps,json=rxBps,proto3" json:"rx_bps,omitempty"` // Incoming bits per second
+	TxPps uint64 `protobuf:"varint,4,opt,name=tx_pps,json=txPps,proto3" json:"tx_pps,omitempty"` // Outgoing packets per second (egress program)
+	TxBps uint64 `protobuf:"varint,5,opt,name=tx_bps,json=txBps,proto3" json:"tx_bps,omitempty"` // Outgoing bits per second (egress program)
+}
+
+func (x *Rates) Reset() {
+	*x = Rates{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[18]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *Rates) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*Rates) ProtoMessage() {}
+
+func (x *Rates) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[18]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use Rates.ProtoReflect.Descriptor instead.
+func (*Rates) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{18}
+}
+
+func (x *Rates) GetTime() uint64 {
+	if x != nil {
+		return x.Time
+	}
+	return 0
+}
+
+func (x *Rates) GetRxPps() uint64 {
+	if x != nil {
+		return x.RxPps
+	}
+	return 0
+}
+
+func (x *Rates) GetRxBps() uint64 {
+	if x != nil {
+		return x.RxBps
+	}
+	return 0
+}
+
+func (x *Rates) GetTxPps() uint64 {
+	if x != nil {
+		return x.TxPps
+	}
+	return 0
+}
+
+func (x *Rates) GetTxBps() uint64 {
+	if x != nil {
+		return x.TxBps
+	}
+	return 0
+}
+
+type RpcStats struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Method  string   `protobuf:"bytes,1,opt,name=method,proto3" json:"method,omitempty"`                   // Name of the RPC
+	Calls   uint64   `protobuf:"varint,2,opt,name=calls,proto3" json:"calls,omitempty"`                    // Number of calls
+	Errors  uint64   `protobuf:"varint,3,opt,name=errors,proto3" json:"errors,omitempty"`                  // Number of calls which returned an error
+	TotalNs uint64   `protobuf:"varint,4,opt,name=total_ns,json=totalNs,proto3" json:"total_ns,omitempty"` // Cumulated duration of the calls
+	Latency []uint64 `protobuf:"varint,5,rep,packed,name=latency,proto3" json:"latency,omitempty"`         // Histogram: latency[i] counts the calls < 2^i µs
+}
+
+func (x *RpcStats) Reset() {
+	*x = RpcStats{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[19]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *RpcStats) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*RpcStats) ProtoMessage() {}
+
+func (x *RpcStats) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[19]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use RpcStats.ProtoReflect.Descriptor instead.
+func (*RpcStats) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{19}
+}
+
+func (x *RpcStats) GetMethod() string {
+	if x != nil {
+		return x.Method
+	}
+	return ""
+}
+
+func (x *RpcStats) GetCalls() uint64 {
+	if x != nil {
+		return x.Calls
+	}
+	return 0
+}
+
+func (x *RpcStats) GetErrors() uint64 {
+	if x != nil {
+		return x.Errors
+	}
+	return 0
+}
+
+func (x *RpcStats) GetTotalNs() uint64 {
+	if x != nil {
+		return x.TotalNs
+	}
+	return 0
+}
+
+func (x *RpcStats) GetLatency() []uint64 {
+	if x != nil {
+		return x.Latency
+	}
+	return nil
+}
+
+type Stats struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Enabled       bool        `protobuf:"varint,1,opt,name=enabled,proto3" json:"enabled,omitempty"`                                    // Instrumentation status (see carnxd --stats)
+	Rpcs          []*RpcStats `protobuf:"bytes,2,rep,name=rpcs,proto3" json:"rpcs,omitempty"`                                           // Measures per RPC
+	CgoCalls      uint64      `protobuf:"varint,3,opt,name=cgo_calls,json=cgoCalls,proto3" json:"cgo_calls,omitempty"`                  // Number of timed calls to libcarnx
+	CgoNs         uint64      `protobuf:"varint,4,opt,name=cgo_ns,json=cgoNs,proto3" json:"cgo_ns,omitempty"`                           // Cumulated duration of these calls
+	MapReadErrors uint64      `protobuf:"varint,5,opt,name=map_read_errors,json=mapReadErrors,proto3" json:"map_read_errors,omitempty"` // Failed lookups of the counter map
+	Mallocs       uint64      `protobuf:"varint,6,opt,name=mallocs,proto3" json:"mallocs,omitempty"`                                    // Go heap objects allocated
+	Frees         uint64      `protobuf:"varint,7,opt,name=frees,proto3" json:"frees,omitempty"`                                        // Go heap objects freed
+	HeapAlloc     uint64      `protobuf:"varint,8,opt,name=heap_alloc,json=heapAlloc,proto3" json:"heap_alloc,omitempty"`               // Go heap bytes in use
+	NumGc         uint64      `protobuf:"varint,9,opt,name=num_gc,json=numGc,proto3" json:"num_gc,omitempty"`                           // Number of GC cycles
+	UptimeNs      uint64      `protobuf:"varint,10,opt,name=uptime_ns,json=uptimeNs,proto3" json:"uptime_ns,omitempty"`                 // Time since the instrumentation is enabled
+}
+
+func (x *Stats) Reset() {
+	*x = Stats{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[20]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *Stats) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*Stats) ProtoMessage() {}
+
+func (x *Stats) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[20]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use Stats.ProtoReflect.Descriptor instead.
+func (*Stats) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{20}
+}
+
+func (x *Stats) GetEnabled() bool {
+	if x != nil {
+		return x.Enabled
+	}
+	return false
+}
+
+func (x *Stats) GetRpcs() []*RpcStats {
+	if x != nil {
+		return x.Rpcs
+	}
+	return nil
+}
+
+func (x *Stats) GetCgoCalls() uint64 {
+	if x != nil {
+		return x.CgoCalls
+	}
+	return 0
+}
+
+func (x *Stats) GetCgoNs() uint64 {
+	if x != nil {
+		return x.CgoNs
+	}
+	return 0
+}
+
+func (x *Stats) GetMapReadErrors() uint64 {
+	if x != nil {
+		return x.MapReadErrors
+	}
+	return 0
+}
+
+func (x *Stats) GetMallocs() uint64 {
+	if x != nil {
+		return x.Mallocs
+	}
+	return 0
+}
+
+func (x *Stats) GetFrees() uint64 {
+	if x != nil {
+		return x.Frees
+	}
+	return 0
+}
+
+func (x *Stats) GetHeapAlloc() uint64 {
+	if x != nil {
+		return x.HeapAlloc
+	}
+	return 0
+}
+
+func (x *Stats) GetNumGc() uint64 {
+	if x != nil {
+		return x.NumGc
+	}
+	return 0
+}
+
+func (x *Stats) GetUptimeNs() uint64 {
+	if x != nil {
+		return x.UptimeNs
+	}
+	return 0
+}
+
 type AttachParameters struct {
 	state         protoimpl.MessageState
 	sizeCache     protoimpl.SizeCache
 	unknownFields protoimpl.UnknownFields
 
-	Interface string `protobuf:"bytes,1,opt,name=interface,proto3" json:"interface,omitempty"`                // Name of the network interface
-	XdpFlags  uint32 `protobuf:"varint,2,opt,name=xdp_flags,json=xdpFlags,proto3" json:"xdp_flags,omitempty"` // XDP attaching flags
+	Interface string `protobuf:"bytes,1,opt,name=interface,proto3" json:"interface,omitempty"`                // Name of the network interface
+	XdpFlags  uint32 `protobuf:"varint,2,opt,name=xdp_flags,json=xdpFlags,proto3" json:"xdp_flags,omitempty"` // XDP attaching flags
+	Chain     bool   `protobuf:"varint,3,opt,name=chain,proto3" json:"chain,omitempty"`                       // Run in front of the XDP program already attached
+}
+
+func (x *AttachParameters) Reset() {
+	*x = AttachParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[21]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *AttachParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*AttachParameters) ProtoMessage() {}
+
+func (x *AttachParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[21]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use AttachParameters.ProtoReflect.Descriptor instead.
+func (*AttachParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{21}
+}
+
+func (x *AttachParameters) GetInterface() string {
+	if x != nil {
+		return x.Interface
+	}
+	return ""
+}
+
+func (x *AttachParameters) GetXdpFlags() uint32 {
+	if x != nil {
+		return x.XdpFlags
+	}
+	return 0
+}
+
+func (x *AttachParameters) GetChain() bool {
+	if x != nil {
+		return x.Chain
+	}
+	return false
+}
+
+type LoadAttachParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Interface  string `protobuf:"bytes,1,opt,name=interface,proto3" json:"interface,omitempty"`                     // Name of the network interface
+	XdpFlags   uint32 `protobuf:"varint,2,opt,name=xdp_flags,json=xdpFlags,proto3" json:"xdp_flags,omitempty"`      // XDP attaching flags
+	BpfProgram string `protobuf:"bytes,3,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path to the eBPF program
+	Features   uint32 `protobuf:"varint,4,opt,name=features,proto3" json:"features,omitempty"`                      // Counter groups to enable (0: default)
+}
+
+func (x *LoadAttachParameters) Reset() {
+	*x = LoadAttachParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[22]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *LoadAttachParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*LoadAttachParameters) ProtoMessage() {}
+
+func (x *LoadAttachParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[22]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use LoadAttachParameters.ProtoReflect.Descriptor instead.
+func (*LoadAttachParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{22}
+}
+
+func (x *LoadAttachParameters) GetInterface() string {
+	if x != nil {
+		return x.Interface
+	}
+	return ""
+}
+
+func (x *LoadAttachParameters) GetXdpFlags() uint32 {
+	if x != nil {
+		return x.XdpFlags
+	}
+	return 0
+}
+
+func (x *LoadAttachParameters) GetBpfProgram() string {
+	if x != nil {
+		return x.BpfProgram
+	}
+	return ""
+}
+
+func (x *LoadAttachParameters) GetFeatures() uint32 {
+	if x != nil {
+		return x.Features
+	}
+	return 0
+}
+
+type LoadParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	BpfProgram string `protobuf:"bytes,1,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path of the BPF program
+	Features   uint32 `protobuf:"varint,2,opt,name=features,proto3" json:"features,omitempty"`                      // Counter groups to enable (0: default)
+}
+
+func (x *LoadParameters) Reset() {
+	*x = LoadParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[23]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *LoadParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*LoadParameters) ProtoMessage() {}
+
+func (x *LoadParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[23]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use LoadParameters.ProtoReflect.Descriptor instead.
+func (*LoadParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{23}
+}
+
+func (x *LoadParameters) GetBpfProgram() string {
+	if x != nil {
+		return x.BpfProgram
+	}
+	return ""
+}
+
+func (x *LoadParameters) GetFeatures() uint32 {
+	if x != nil {
+		return x.Features
+	}
+	return 0
+}
+
+type UpgradeParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	BpfProgram string `protobuf:"bytes,1,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path to the new eBPF program
+	Features   uint32 `protobuf:"varint,2,opt,name=features,proto3" json:"features,omitempty"`                      // Counter groups to enable (0: default)
 }
 
-func (x *AttachParameters) Reset() {
-	*x = AttachParameters{}
+func (x *UpgradeParameters) Reset() {
+	*x = UpgradeParameters{}
 	if protoimpl.UnsafeEnabled {
-		mi := &file_api_carnx_proto_msgTypes[8]
+		mi := &file_api_carnx_proto_msgTypes[24]
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		ms.StoreMessageInfo(mi)
 	}
 }
 
-func (x *AttachParameters) String() string {
+func (x *UpgradeParameters) String() string {
 	return protoimpl.X.MessageStringOf(x)
 }
 
-func (*AttachParameters) ProtoMessage() {}
+func (*UpgradeParameters) ProtoMessage() {}
 
-func (x *AttachParameters) ProtoReflect() protoreflect.Message {
-	mi := &file_api_carnx_proto_msgTypes[8]
+func (x *UpgradeParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[24]
 	if protoimpl.UnsafeEnabled && x != nil {
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		if ms.LoadMessageInfo() == nil {
@@ -432,52 +1528,51 @@ func (x *AttachParameters) ProtoReflect() protoreflect.Message {
 	return mi.MessageOf(x)
 }
 
-// Deprecated: Use AttachParameters.ProtoReflect.Descriptor instead.
-func (*AttachParameters) Descriptor() ([]byte, []int) {
-	return file_api_carnx_proto_rawDescGZIP(), []int{8}
+// Deprecated: Use UpgradeParameters.ProtoReflect.Descriptor instead.
+func (*UpgradeParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{24}
 }
 
-func (x *AttachParameters) GetInterface() string {
+func (x *UpgradeParameters) GetBpfProgram() string {
 	if x != nil {
-		return x.Interface
+		return x.BpfProgram
 	}
 	return ""
 }
 
-func (x *AttachParameters) GetXdpFlags() uint32 {
+func (x *UpgradeParameters) GetFeatures() uint32 {
 	if x != nil {
-		return x.XdpFlags
+		return x.Features
 	}
 	return 0
 }
 
-type LoadAttachParameters struct {
+type StageParameters struct {
 	state         protoimpl.MessageState
 	sizeCache     protoimpl.SizeCache
 	unknownFields protoimpl.UnknownFields
 
-	Interface  string `protobuf:"bytes,1,opt,name=interface,proto3" json:"interface,omitempty"`                     // Name of the network interface
-	XdpFlags   uint32 `protobuf:"varint,2,opt,name=xdp_flags,json=xdpFlags,proto3" json:"xdp_flags,omitempty"`      // XDP attaching flags
-	BpfProgram string `protobuf:"bytes,3,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path to the eBPF program
+	Stage      uint32 `protobuf:"varint,1,opt,name=stage,proto3" json:"stage,omitempty"`                            // Slot of the parser pipeline (0: L3, 1: L4, 2: app)
+	BpfProgram string `protobuf:"bytes,2,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path to the eBPF program implementing the stage
 }
 
-func (x *LoadAttachParameters) Reset() {
-	*x = LoadAttachParameters{}
+func (x *StageParameters) Reset() {
+	*x = StageParameters{}
 	if protoimpl.UnsafeEnabled {
-		mi := &file_api_carnx_proto_msgTypes[9]
+		mi := &file_api_carnx_proto_msgTypes[25]
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		ms.StoreMessageInfo(mi)
 	}
 }
 
-func (x *LoadAttachParameters) String() string {
+func (x *StageParameters) String() string {
 	return protoimpl.X.MessageStringOf(x)
 }
 
-func (*LoadAttachParameters) ProtoMessage() {}
+func (*StageParameters) ProtoMessage() {}
 
-func (x *LoadAttachParameters) ProtoReflect() protoreflect.Message {
-	mi := &file_api_carnx_proto_msgTypes[9]
+func (x *StageParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[25]
 	if protoimpl.UnsafeEnabled && x != nil {
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		if ms.LoadMessageInfo() == nil {
@@ -488,57 +1583,50 @@ func (x *LoadAttachParameters) ProtoReflect() protoreflect.Message {
 	return mi.MessageOf(x)
 }
 
-// Deprecated: Use LoadAttachParameters.ProtoReflect.Descriptor instead.
-func (*LoadAttachParameters) Descriptor() ([]byte, []int) {
-	return file_api_carnx_proto_rawDescGZIP(), []int{9}
-}
-
-func (x *LoadAttachParameters) GetInterface() string {
-	if x != nil {
-		return x.Interface
-	}
-	return ""
+// Deprecated: Use StageParameters.ProtoReflect.Descriptor instead.
+func (*StageParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{25}
 }
 
-func (x *LoadAttachParameters) GetXdpFlags() uint32 {
+func (x *StageParameters) GetStage() uint32 {
 	if x != nil {
-		return x.XdpFlags
+		return x.Stage
 	}
 	return 0
 }
 
-func (x *LoadAttachParameters) GetBpfProgram() string {
+func (x *StageParameters) GetBpfProgram() string {
 	if x != nil {
 		return x.BpfProgram
 	}
 	return ""
 }
 
-type LoadParameters struct {
+type StageID struct {
 	state         protoimpl.MessageState
 	sizeCache     protoimpl.SizeCache
 	unknownFields protoimpl.UnknownFields
 
-	BpfProgram string `protobuf:"bytes,1,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path of the BPF program
+	Stage uint32 `protobuf:"varint,1,opt,name=stage,proto3" json:"stage,omitempty"` // Slot of the parser pipeline (0: L3, 1: L4, 2: app)
 }
 
-func (x *LoadParameters) Reset() {
-	*x = LoadParameters{}
+func (x *StageID) Reset() {
+	*x = StageID{}
 	if protoimpl.UnsafeEnabled {
-		mi := &file_api_carnx_proto_msgTypes[10]
+		mi := &file_api_carnx_proto_msgTypes[26]
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		ms.StoreMessageInfo(mi)
 	}
 }
 
-func (x *LoadParameters) String() string {
+func (x *StageID) String() string {
 	return protoimpl.X.MessageStringOf(x)
 }
 
-func (*LoadParameters) ProtoMessage() {}
+func (*StageID) ProtoMessage() {}
 
-func (x *LoadParameters) ProtoReflect() protoreflect.Message {
-	mi := &file_api_carnx_proto_msgTypes[10]
+func (x *StageID) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[26]
 	if protoimpl.UnsafeEnabled && x != nil {
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		if ms.LoadMessageInfo() == nil {
@@ -549,16 +1637,16 @@ func (x *LoadParameters) ProtoReflect() protoreflect.Message {
 	return mi.MessageOf(x)
 }
 
-// Deprecated: Use LoadParameters.ProtoReflect.Descriptor instead.
-func (*LoadParameters) Descriptor() ([]byte, []int) {
-	return file_api_carnx_proto_rawDescGZIP(), []int{10}
+// Deprecated: Use StageID.ProtoReflect.Descriptor instead.
+func (*StageID) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{26}
 }
 
-func (x *LoadParameters) GetBpfProgram() string {
+func (x *StageID) GetStage() uint32 {
 	if x != nil {
-		return x.BpfProgram
+		return x.Stage
 	}
-	return ""
+	return 0
 }
 
 type LoadStatus struct {
@@ -572,7 +1660,7 @@ type LoadStatus struct {
 func (x *LoadStatus) Reset() {
 	*x = LoadStatus{}
 	if protoimpl.UnsafeEnabled {
-		mi := &file_api_carnx_proto_msgTypes[11]
+		mi := &file_api_carnx_proto_msgTypes[27]
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		ms.StoreMessageInfo(mi)
 	}
@@ -585,7 +1673,7 @@ func (x *LoadStatus) String() string {
 func (*LoadStatus) ProtoMessage() {}
 
 func (x *LoadStatus) ProtoReflect() protoreflect.Message {
-	mi := &file_api_carnx_proto_msgTypes[11]
+	mi := &file_api_carnx_proto_msgTypes[27]
 	if protoimpl.UnsafeEnabled && x != nil {
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		if ms.LoadMessageInfo() == nil {
@@ -598,7 +1686,7 @@ func (x *LoadStatus) ProtoReflect() protoreflect.Message {
 
 // Deprecated: Use LoadStatus.ProtoReflect.Descriptor instead.
 func (*LoadStatus) Descriptor() ([]byte, []int) {
-	return file_api_carnx_proto_rawDescGZIP(), []int{11}
+	return file_api_carnx_proto_rawDescGZIP(), []int{27}
 }
 
 func (x *LoadStatus) GetLoaded() bool {
@@ -614,12 +1702,13 @@ type AttachStatus struct {
 	unknownFields protoimpl.UnknownFields
 
 	Attached bool `protobuf:"varint,1,opt,name=attached,proto3" json:"attached,omitempty"` // Status of the BPF program
+	Chained  bool `protobuf:"varint,2,opt,name=chained,proto3" json:"chained,omitempty"`   // The BPF program hands the packets to another one
 }
 
 func (x *AttachStatus) Reset() {
 	*x = AttachStatus{}
 	if protoimpl.UnsafeEnabled {
-		mi := &file_api_carnx_proto_msgTypes[12]
+		mi := &file_api_carnx_proto_msgTypes[28]
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		ms.StoreMessageInfo(mi)
 	}
@@ -632,7 +1721,7 @@ func (x *AttachStatus) String() string {
 func (*AttachStatus) ProtoMessage() {}
 
 func (x *AttachStatus) ProtoReflect() protoreflect.Message {
-	mi := &file_api_carnx_proto_msgTypes[12]
+	mi := &file_api_carnx_proto_msgTypes[28]
 	if protoimpl.UnsafeEnabled && x != nil {
 		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
 		if ms.LoadMessageInfo() == nil {
@@ -645,7 +1734,7 @@ func (x *AttachStatus) ProtoReflect() protoreflect.Message {
 
 // Deprecated: Use AttachStatus.ProtoReflect.Descriptor instead.
 func (*AttachStatus) Descriptor() ([]byte, []int) {
-	return file_api_carnx_proto_rawDescGZIP(), []int{12}
+	return file_api_carnx_proto_rawDescGZIP(), []int{28}
 }
 
 func (x *AttachStatus) GetAttached() bool {
@@ -655,6 +1744,131 @@ func (x *AttachStatus) GetAttached() bool {
 	return false
 }
 
+func (x *AttachStatus) GetChained() bool {
+	if x != nil {
+		return x.Chained
+	}
+	return false
+}
+
+type HopParameters struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	BpfProgram string `protobuf:"bytes,1,opt,name=bpf_program,json=bpfProgram,proto3" json:"bpf_program,omitempty"` // Path to the eBPF program
+	Features   uint32 `protobuf:"varint,2,opt,name=features,proto3" json:"features,omitempty"`                      // Counter groups to enable (0: default)
+	Repeat     uint32 `protobuf:"varint,3,opt,name=repeat,proto3" json:"repeat,omitempty"`                          // Number of runs (0: 100000)
+}
+
+func (x *HopParameters) Reset() {
+	*x = HopParameters{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[29]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *HopParameters) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*HopParameters) ProtoMessage() {}
+
+func (x *HopParameters) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[29]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use HopParameters.ProtoReflect.Descriptor instead.
+func (*HopParameters) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{29}
+}
+
+func (x *HopParameters) GetBpfProgram() string {
+	if x != nil {
+		return x.BpfProgram
+	}
+	return ""
+}
+
+func (x *HopParameters) GetFeatures() uint32 {
+	if x != nil {
+		return x.Features
+	}
+	return 0
+}
+
+func (x *HopParameters) GetRepeat() uint32 {
+	if x != nil {
+		return x.Repeat
+	}
+	return 0
+}
+
+type HopCost struct {
+	state         protoimpl.MessageState
+	sizeCache     protoimpl.SizeCache
+	unknownFields protoimpl.UnknownFields
+
+	Alone   uint32 `protobuf:"varint,1,opt,name=alone,proto3" json:"alone,omitempty"`     // Average duration of the pipeline (ns)
+	Chained uint32 `protobuf:"varint,2,opt,name=chained,proto3" json:"chained,omitempty"` // Average duration when a program is chained (ns)
+}
+
+func (x *HopCost) Reset() {
+	*x = HopCost{}
+	if protoimpl.UnsafeEnabled {
+		mi := &file_api_carnx_proto_msgTypes[30]
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		ms.StoreMessageInfo(mi)
+	}
+}
+
+func (x *HopCost) String() string {
+	return protoimpl.X.MessageStringOf(x)
+}
+
+func (*HopCost) ProtoMessage() {}
+
+func (x *HopCost) ProtoReflect() protoreflect.Message {
+	mi := &file_api_carnx_proto_msgTypes[30]
+	if protoimpl.UnsafeEnabled && x != nil {
+		ms := protoimpl.X.MessageStateOf(protoimpl.Pointer(x))
+		if ms.LoadMessageInfo() == nil {
+			ms.StoreMessageInfo(mi)
+		}
+		return ms
+	}
+	return mi.MessageOf(x)
+}
+
+// Deprecated: Use HopCost.ProtoReflect.Descriptor instead.
+func (*HopCost) Descriptor() ([]byte, []int) {
+	return file_api_carnx_proto_rawDescGZIP(), []int{30}
+}
+
+func (x *HopCost) GetAlone() uint32 {
+	if x != nil {
+		return x.Alone
+	}
+	return 0
+}
+
+func (x *HopCost) GetChained() uint32 {
+	if x != nil {
+		return x.Chained
+	}
+	return 0
+}
+
 var File_api_carnx_proto protoreflect.FileDescriptor
 
 var file_api_carnx_proto_rawDesc = []byte{
@@ -680,69 +1894,245 @@ var file_api_carnx_proto_rawDesc = []byte{
 	0x64, 0x61, 0x74, 0x61, 0x1a, 0x37, 0x0a, 0x09, 0x44, 0x61, 0x74, 0x61, 0x45, 0x6e, 0x74, 0x72,
 	0x79, 0x12, 0x10, 0x0a, 0x03, 0x6b, 0x65, 0x79, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x03,
 	0x6b, 0x65, 0x79, 0x12, 0x14, 0x0a, 0x05, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x18, 0x02, 0x20, 0x01,
-	0x28, 0x04, 0x52, 0x05, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3a, 0x02, 0x38, 0x01, 0x22, 0x4d, 0x0a,
-	0x10, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72,
-	0x73, 0x12, 0x1c, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61, 0x63, 0x65, 0x18, 0x01,
-	0x20, 0x01, 0x28, 0x09, 0x52, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61, 0x63, 0x65, 0x12,
-	0x1b, 0x0a, 0x09, 0x78, 0x64, 0x70, 0x5f, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x18, 0x02, 0x20, 0x01,
-	0x28, 0x0d, 0x52, 0x08, 0x78, 0x64, 0x70, 0x46, 0x6c, 0x61, 0x67, 0x73, 0x22, 0x72, 0x0a, 0x14,
-	0x4c, 0x6f, 0x61, 0x64, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65,
-	0x74, 0x65, 0x72, 0x73, 0x12, 0x1c, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61, 0x63,
-	0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61,
-	0x63, 0x65, 0x12, 0x1b, 0x0a, 0x09, 0x78, 0x64, 0x70, 0x5f, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x18,
-	0x02, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x08, 0x78, 0x64, 0x70, 0x46, 0x6c, 0x61, 0x67, 0x73, 0x12,
-	0x1f, 0x0a, 0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x18, 0x03,
-	0x20, 0x01, 0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d,
-	0x22, 0x31, 0x0a, 0x0e, 0x4c, 0x6f, 0x61, 0x64, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65,
-	0x72, 0x73, 0x12, 0x1f, 0x0a, 0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61,
-	0x6d, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f, 0x67,
-	0x72, 0x61, 0x6d, 0x22, 0x24, 0x0a, 0x0a, 0x4c, 0x6f, 0x61, 0x64, 0x53, 0x74, 0x61, 0x74, 0x75,
-	0x73, 0x12, 0x16, 0x0a, 0x06, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x18, 0x01, 0x20, 0x01, 0x28,
-	0x08, 0x52, 0x06, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x22, 0x2a, 0x0a, 0x0c, 0x41, 0x74, 0x74,
-	0x61, 0x63, 0x68, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x12, 0x1a, 0x0a, 0x08, 0x61, 0x74, 0x74,
-	0x61, 0x63, 0x68, 0x65, 0x64, 0x18, 0x01, 0x20, 0x01, 0x28, 0x08, 0x52, 0x08, 0x61, 0x74, 0x74,
-	0x61, 0x63, 0x68, 0x65, 0x64, 0x32, 0x80, 0x05, 0x0a, 0x05, 0x43, 0x61, 0x72, 0x6e, 0x78, 0x12,
-	0x30, 0x0a, 0x0d, 0x47, 0x65, 0x74, 0x4e, 0x62, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73,
-	0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f,
-	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4e, 0x62, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73, 0x22,
-	0x00, 0x12, 0x24, 0x0a, 0x04, 0x50, 0x69, 0x6e, 0x67, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e,
-	0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61,
-	0x72, 0x62, 0x61, 0x67, 0x65, 0x22, 0x00, 0x12, 0x31, 0x0a, 0x0a, 0x47, 0x65, 0x74, 0x43, 0x6f,
-	0x75, 0x6e, 0x74, 0x65, 0x72, 0x12, 0x0e, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e,
-	0x74, 0x65, 0x72, 0x49, 0x44, 0x1a, 0x11, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e,
-	0x74, 0x65, 0x72, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x22, 0x00, 0x12, 0x39, 0x0a, 0x10, 0x47, 0x65,
-	0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x42, 0x79, 0x4e, 0x61, 0x6d, 0x65, 0x12, 0x10,
-	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x4e, 0x61, 0x6d, 0x65,
-	0x1a, 0x11, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x56, 0x61,
-	0x6c, 0x75, 0x65, 0x22, 0x00, 0x12, 0x33, 0x0a, 0x0f, 0x47, 0x65, 0x74, 0x43, 0x6f, 0x75, 0x6e,
-	0x74, 0x65, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x73, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47,
-	0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x10, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75,
-	0x6e, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x73, 0x74, 0x22, 0x00, 0x12, 0x25, 0x0a, 0x08, 0x53, 0x6e,
-	0x61, 0x70, 0x73, 0x68, 0x6f, 0x74, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72,
-	0x62, 0x61, 0x67, 0x65, 0x1a, 0x09, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x6e, 0x61, 0x70, 0x22,
-	0x00, 0x12, 0x2e, 0x0a, 0x04, 0x4c, 0x6f, 0x61, 0x64, 0x12, 0x13, 0x2e, 0x61, 0x70, 0x69, 0x2e,
-	0x4c, 0x6f, 0x61, 0x64, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f,
-	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22,
-	0x00, 0x12, 0x3d, 0x0a, 0x0d, 0x4c, 0x6f, 0x61, 0x64, 0x41, 0x6e, 0x64, 0x41, 0x74, 0x74, 0x61,
-	0x63, 0x68, 0x12, 0x19, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4c, 0x6f, 0x61, 0x64, 0x41, 0x74, 0x74,
-	0x61, 0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e,
-	0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00,
-	0x12, 0x29, 0x0a, 0x06, 0x55, 0x6e, 0x6c, 0x6f, 0x61, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69,
+	0x28, 0x04, 0x52, 0x05, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3a, 0x02, 0x38, 0x01, 0x22, 0x2f, 0x0a,
+	0x10, 0x53, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72,
+	0x73, 0x12, 0x1b, 0x0a, 0x09, 0x70, 0x65, 0x72, 0x69, 0x6f, 0x64, 0x5f, 0x6d, 0x73, 0x18, 0x01,
+	0x20, 0x01, 0x28, 0x0d, 0x52, 0x08, 0x70, 0x65, 0x72, 0x69, 0x6f, 0x64, 0x4d, 0x73, 0x22, 0xc8,
+	0x01, 0x0a, 0x0a, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x53, 0x6e, 0x61, 0x70, 0x12, 0x16, 0x0a,
+	0x06, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x06, 0x73,
+	0x6f, 0x75, 0x72, 0x63, 0x65, 0x12, 0x0e, 0x0a, 0x02, 0x75, 0x70, 0x18, 0x02, 0x20, 0x01, 0x28,
+	0x08, 0x52, 0x02, 0x75, 0x70, 0x12, 0x14, 0x0a, 0x05, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x18, 0x03,
+	0x20, 0x01, 0x28, 0x09, 0x52, 0x05, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x12, 0x2d, 0x0a, 0x04, 0x64,
+	0x61, 0x74, 0x61, 0x18, 0x04, 0x20, 0x03, 0x28, 0x0b, 0x32, 0x19, 0x2e, 0x61, 0x70, 0x69, 0x2e,
+	0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x53, 0x6e, 0x61, 0x70, 0x2e, 0x44, 0x61, 0x74, 0x61, 0x45,
+	0x6e, 0x74, 0x72, 0x79, 0x52, 0x04, 0x64, 0x61, 0x74, 0x61, 0x12, 0x14, 0x0a, 0x05, 0x73, 0x74,
+	0x61, 0x6c, 0x65, 0x18, 0x05, 0x20, 0x01, 0x28, 0x08, 0x52, 0x05, 0x73, 0x74, 0x61, 0x6c, 0x65,
+	0x1a, 0x37, 0x0a, 0x09, 0x44, 0x61, 0x74, 0x61, 0x45, 0x6e, 0x74, 0x72, 0x79, 0x12, 0x10, 0x0a,
+	0x03, 0x6b, 0x65, 0x79, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x03, 0x6b, 0x65, 0x79, 0x12,
+	0x14, 0x0a, 0x05, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x18, 0x02, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05,
+	0x76, 0x61, 0x6c, 0x75, 0x65, 0x3a, 0x02, 0x38, 0x01, 0x22, 0xb7, 0x01, 0x0a, 0x0a, 0x4d, 0x65,
+	0x72, 0x67, 0x65, 0x64, 0x53, 0x6e, 0x61, 0x70, 0x12, 0x12, 0x0a, 0x04, 0x74, 0x69, 0x6d, 0x65,
+	0x18, 0x01, 0x20, 0x01, 0x28, 0x04, 0x52, 0x04, 0x74, 0x69, 0x6d, 0x65, 0x12, 0x29, 0x0a, 0x07,
+	0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x73, 0x18, 0x02, 0x20, 0x03, 0x28, 0x0b, 0x32, 0x0f, 0x2e,
+	0x61, 0x70, 0x69, 0x2e, 0x53, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x53, 0x6e, 0x61, 0x70, 0x52, 0x07,
+	0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x73, 0x12, 0x30, 0x0a, 0x05, 0x74, 0x6f, 0x74, 0x61, 0x6c,
+	0x18, 0x03, 0x20, 0x03, 0x28, 0x0b, 0x32, 0x1a, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4d, 0x65, 0x72,
+	0x67, 0x65, 0x64, 0x53, 0x6e, 0x61, 0x70, 0x2e, 0x54, 0x6f, 0x74, 0x61, 0x6c, 0x45, 0x6e, 0x74,
+	0x72, 0x79, 0x52, 0x05, 0x74, 0x6f, 0x74, 0x61, 0x6c, 0x1a, 0x38, 0x0a, 0x0a, 0x54, 0x6f, 0x74,
+	0x61, 0x6c, 0x45, 0x6e, 0x74, 0x72, 0x79, 0x12, 0x10, 0x0a, 0x03, 0x6b, 0x65, 0x79, 0x18, 0x01,
+	0x20, 0x01, 0x28, 0x09, 0x52, 0x03, 0x6b, 0x65, 0x79, 0x12, 0x14, 0x0a, 0x05, 0x76, 0x61, 0x6c,
+	0x75, 0x65, 0x18, 0x02, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x3a,
+	0x02, 0x38, 0x01, 0x22, 0x20, 0x0a, 0x10, 0x53, 0x6e, 0x69, 0x54, 0x6f, 0x70, 0x50, 0x61, 0x72,
+	0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x12, 0x0c, 0x0a, 0x01, 0x6b, 0x18, 0x01, 0x20, 0x01,
+	0x28, 0x0d, 0x52, 0x01, 0x6b, 0x22, 0x34, 0x0a, 0x08, 0x53, 0x6e, 0x69, 0x43, 0x6f, 0x75, 0x6e,
+	0x74, 0x12, 0x12, 0x0a, 0x04, 0x68, 0x61, 0x73, 0x68, 0x18, 0x01, 0x20, 0x01, 0x28, 0x0d, 0x52,
+	0x04, 0x68, 0x61, 0x73, 0x68, 0x12, 0x14, 0x0a, 0x05, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x18, 0x02,
+	0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x22, 0x31, 0x0a, 0x06, 0x53,
+	0x6e, 0x69, 0x54, 0x6f, 0x70, 0x12, 0x27, 0x0a, 0x07, 0x65, 0x6e, 0x74, 0x72, 0x69, 0x65, 0x73,
+	0x18, 0x01, 0x20, 0x03, 0x28, 0x0b, 0x32, 0x0d, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x6e, 0x69,
+	0x43, 0x6f, 0x75, 0x6e, 0x74, 0x52, 0x07, 0x65, 0x6e, 0x74, 0x72, 0x69, 0x65, 0x73, 0x22, 0x26,
+	0x0a, 0x10, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65,
+	0x72, 0x73, 0x12, 0x12, 0x0a, 0x04, 0x72, 0x61, 0x74, 0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x0d,
+	0x52, 0x04, 0x72, 0x61, 0x74, 0x65, 0x22, 0xce, 0x01, 0x0a, 0x06, 0x53, 0x61, 0x6d, 0x70, 0x6c,
+	0x65, 0x12, 0x1c, 0x0a, 0x09, 0x74, 0x69, 0x6d, 0x65, 0x73, 0x74, 0x61, 0x6d, 0x70, 0x18, 0x01,
+	0x20, 0x01, 0x28, 0x04, 0x52, 0x09, 0x74, 0x69, 0x6d, 0x65, 0x73, 0x74, 0x61, 0x6d, 0x70, 0x12,
+	0x18, 0x0a, 0x07, 0x69, 0x66, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x18, 0x02, 0x20, 0x01, 0x28, 0x0d,
+	0x52, 0x07, 0x69, 0x66, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x12, 0x10, 0x0a, 0x03, 0x63, 0x70, 0x75,
+	0x18, 0x03, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x03, 0x63, 0x70, 0x75, 0x12, 0x16, 0x0a, 0x06, 0x6c,
+	0x65, 0x6e, 0x67, 0x74, 0x68, 0x18, 0x04, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x06, 0x6c, 0x65, 0x6e,
+	0x67, 0x74, 0x68, 0x12, 0x19, 0x0a, 0x08, 0x6c, 0x33, 0x5f, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x18,
+	0x05, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x07, 0x6c, 0x33, 0x50, 0x72, 0x6f, 0x74, 0x6f, 0x12, 0x19,
+	0x0a, 0x08, 0x6c, 0x34, 0x5f, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x18, 0x06, 0x20, 0x01, 0x28, 0x0d,
+	0x52, 0x07, 0x6c, 0x34, 0x50, 0x72, 0x6f, 0x74, 0x6f, 0x12, 0x12, 0x0a, 0x04, 0x64, 0x61, 0x74,
+	0x61, 0x18, 0x07, 0x20, 0x01, 0x28, 0x0c, 0x52, 0x04, 0x64, 0x61, 0x74, 0x61, 0x12, 0x18, 0x0a,
+	0x07, 0x64, 0x72, 0x6f, 0x70, 0x70, 0x65, 0x64, 0x18, 0x08, 0x20, 0x01, 0x28, 0x04, 0x52, 0x07,
+	0x64, 0x72, 0x6f, 0x70, 0x70, 0x65, 0x64, 0x22, 0x87, 0x01, 0x0a, 0x0b, 0x43, 0x6f, 0x75, 0x6e,
+	0x74, 0x65, 0x72, 0x49, 0x6e, 0x66, 0x6f, 0x12, 0x0e, 0x0a, 0x02, 0x69, 0x64, 0x18, 0x01, 0x20,
+	0x01, 0x28, 0x0d, 0x52, 0x02, 0x69, 0x64, 0x12, 0x12, 0x0a, 0x04, 0x6e, 0x61, 0x6d, 0x65, 0x18,
+	0x02, 0x20, 0x01, 0x28, 0x09, 0x52, 0x04, 0x6e, 0x61, 0x6d, 0x65, 0x12, 0x14, 0x0a, 0x05, 0x67,
+	0x72, 0x6f, 0x75, 0x70, 0x18, 0x03, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x05, 0x67, 0x72, 0x6f, 0x75,
+	0x70, 0x12, 0x12, 0x0a, 0x04, 0x74, 0x79, 0x70, 0x65, 0x18, 0x04, 0x20, 0x01, 0x28, 0x09, 0x52,
+	0x04, 0x74, 0x79, 0x70, 0x65, 0x12, 0x12, 0x0a, 0x04, 0x75, 0x6e, 0x69, 0x74, 0x18, 0x05, 0x20,
+	0x01, 0x28, 0x09, 0x52, 0x04, 0x75, 0x6e, 0x69, 0x74, 0x12, 0x16, 0x0a, 0x06, 0x61, 0x63, 0x74,
+	0x69, 0x76, 0x65, 0x18, 0x06, 0x20, 0x01, 0x28, 0x08, 0x52, 0x06, 0x61, 0x63, 0x74, 0x69, 0x76,
+	0x65, 0x22, 0x4a, 0x0a, 0x06, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x12, 0x12, 0x0a, 0x04, 0x68,
+	0x61, 0x73, 0x68, 0x18, 0x01, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x04, 0x68, 0x61, 0x73, 0x68, 0x12,
+	0x2c, 0x0a, 0x08, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73, 0x18, 0x02, 0x20, 0x03, 0x28,
+	0x0b, 0x32, 0x10, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x49,
+	0x6e, 0x66, 0x6f, 0x52, 0x08, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73, 0x22, 0x77, 0x0a,
+	0x05, 0x52, 0x61, 0x74, 0x65, 0x73, 0x12, 0x12, 0x0a, 0x04, 0x74, 0x69, 0x6d, 0x65, 0x18, 0x01,
+	0x20, 0x01, 0x28, 0x04, 0x52, 0x04, 0x74, 0x69, 0x6d, 0x65, 0x12, 0x15, 0x0a, 0x06, 0x72, 0x78,
+	0x5f, 0x70, 0x70, 0x73, 0x18, 0x02, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x72, 0x78, 0x50, 0x70,
+	0x73, 0x12, 0x15, 0x0a, 0x06, 0x72, 0x78, 0x5f, 0x62, 0x70, 0x73, 0x18, 0x03, 0x20, 0x01, 0x28,
+	0x04, 0x52, 0x05, 0x72, 0x78, 0x42, 0x70, 0x73, 0x12, 0x15, 0x0a, 0x06, 0x74, 0x78, 0x5f, 0x70,
+	0x70, 0x73, 0x18, 0x04, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x74, 0x78, 0x50, 0x70, 0x73, 0x12,
+	0x15, 0x0a, 0x06, 0x74, 0x78, 0x5f, 0x62, 0x70, 0x73, 0x18, 0x05, 0x20, 0x01, 0x28, 0x04, 0x52,
+	0x05, 0x74, 0x78, 0x42, 0x70, 0x73, 0x22, 0x85, 0x01, 0x0a, 0x08, 0x52, 0x70, 0x63, 0x53, 0x74,
+	0x61, 0x74, 0x73, 0x12, 0x16, 0x0a, 0x06, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x18, 0x01, 0x20,
+	0x01, 0x28, 0x09, 0x52, 0x06, 0x6d, 0x65, 0x74, 0x68, 0x6f, 0x64, 0x12, 0x14, 0x0a, 0x05, 0x63,
+	0x61, 0x6c, 0x6c, 0x73, 0x18, 0x02, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x63, 0x61, 0x6c, 0x6c,
+	0x73, 0x12, 0x16, 0x0a, 0x06, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x73, 0x18, 0x03, 0x20, 0x01, 0x28,
+	0x04, 0x52, 0x06, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x73, 0x12, 0x19, 0x0a, 0x08, 0x74, 0x6f, 0x74,
+	0x61, 0x6c, 0x5f, 0x6e, 0x73, 0x18, 0x04, 0x20, 0x01, 0x28, 0x04, 0x52, 0x07, 0x74, 0x6f, 0x74,
+	0x61, 0x6c, 0x4e, 0x73, 0x12, 0x18, 0x0a, 0x07, 0x6c, 0x61, 0x74, 0x65, 0x6e, 0x63, 0x79, 0x18,
+	0x05, 0x20, 0x03, 0x28, 0x04, 0x52, 0x07, 0x6c, 0x61, 0x74, 0x65, 0x6e, 0x63, 0x79, 0x22, 0xa3,
+	0x02, 0x0a, 0x05, 0x53, 0x74, 0x61, 0x74, 0x73, 0x12, 0x18, 0x0a, 0x07, 0x65, 0x6e, 0x61, 0x62,
+	0x6c, 0x65, 0x64, 0x18, 0x01, 0x20, 0x01, 0x28, 0x08, 0x52, 0x07, 0x65, 0x6e, 0x61, 0x62, 0x6c,
+	0x65, 0x64, 0x12, 0x21, 0x0a, 0x04, 0x72, 0x70, 0x63, 0x73, 0x18, 0x02, 0x20, 0x03, 0x28, 0x0b,
+	0x32, 0x0d, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x70, 0x63, 0x53, 0x74, 0x61, 0x74, 0x73, 0x52,
+	0x04, 0x72, 0x70, 0x63, 0x73, 0x12, 0x1b, 0x0a, 0x09, 0x63, 0x67, 0x6f, 0x5f, 0x63, 0x61, 0x6c,
+	0x6c, 0x73, 0x18, 0x03, 0x20, 0x01, 0x28, 0x04, 0x52, 0x08, 0x63, 0x67, 0x6f, 0x43, 0x61, 0x6c,
+	0x6c, 0x73, 0x12, 0x15, 0x0a, 0x06, 0x63, 0x67, 0x6f, 0x5f, 0x6e, 0x73, 0x18, 0x04, 0x20, 0x01,
+	0x28, 0x04, 0x52, 0x05, 0x63, 0x67, 0x6f, 0x4e, 0x73, 0x12, 0x26, 0x0a, 0x0f, 0x6d, 0x61, 0x70,
+	0x5f, 0x72, 0x65, 0x61, 0x64, 0x5f, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x73, 0x18, 0x05, 0x20, 0x01,
+	0x28, 0x04, 0x52, 0x0d, 0x6d, 0x61, 0x70, 0x52, 0x65, 0x61, 0x64, 0x45, 0x72, 0x72, 0x6f, 0x72,
+	0x73, 0x12, 0x18, 0x0a, 0x07, 0x6d, 0x61, 0x6c, 0x6c, 0x6f, 0x63, 0x73, 0x18, 0x06, 0x20, 0x01,
+	0x28, 0x04, 0x52, 0x07, 0x6d, 0x61, 0x6c, 0x6c, 0x6f, 0x63, 0x73, 0x12, 0x14, 0x0a, 0x05, 0x66,
+	0x72, 0x65, 0x65, 0x73, 0x18, 0x07, 0x20, 0x01, 0x28, 0x04, 0x52, 0x05, 0x66, 0x72, 0x65, 0x65,
+	0x73, 0x12, 0x1d, 0x0a, 0x0a, 0x68, 0x65, 0x61, 0x70, 0x5f, 0x61, 0x6c, 0x6c, 0x6f, 0x63, 0x18,
+	0x08, 0x20, 0x01, 0x28, 0x04, 0x52, 0x09, 0x68, 0x65, 0x61, 0x70, 0x41, 0x6c, 0x6c, 0x6f, 0x63,
+	0x12, 0x15, 0x0a, 0x06, 0x6e, 0x75, 0x6d, 0x5f, 0x67, 0x63, 0x18, 0x09, 0x20, 0x01, 0x28, 0x04,
+	0x52, 0x05, 0x6e, 0x75, 0x6d, 0x47, 0x63, 0x12, 0x1b, 0x0a, 0x09, 0x75, 0x70, 0x74, 0x69, 0x6d,
+	0x65, 0x5f, 0x6e, 0x73, 0x18, 0x0a, 0x20, 0x01, 0x28, 0x04, 0x52, 0x08, 0x75, 0x70, 0x74, 0x69,
+	0x6d, 0x65, 0x4e, 0x73, 0x22, 0x63, 0x0a, 0x10, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x50, 0x61,
+	0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x12, 0x1c, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x65,
+	0x72, 0x66, 0x61, 0x63, 0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x09, 0x69, 0x6e, 0x74,
+	0x65, 0x72, 0x66, 0x61, 0x63, 0x65, 0x12, 0x1b, 0x0a, 0x09, 0x78, 0x64, 0x70, 0x5f, 0x66, 0x6c,
+	0x61, 0x67, 0x73, 0x18, 0x02, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x08, 0x78, 0x64, 0x70, 0x46, 0x6c,
+	0x61, 0x67, 0x73, 0x12, 0x14, 0x0a, 0x05, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x18, 0x03, 0x20, 0x01,
+	0x28, 0x08, 0x52, 0x05, 0x63, 0x68, 0x61, 0x69, 0x6e, 0x22, 0x8e, 0x01, 0x0a, 0x14, 0x4c, 0x6f,
+	0x61, 0x64, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65,
+	0x72, 0x73, 0x12, 0x1c, 0x0a, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61, 0x63, 0x65, 0x18,
+	0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x09, 0x69, 0x6e, 0x74, 0x65, 0x72, 0x66, 0x61, 0x63, 0x65,
+	0x12, 0x1b, 0x0a, 0x09, 0x78, 0x64, 0x70, 0x5f, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x18, 0x02, 0x20,
+	0x01, 0x28, 0x0d, 0x52, 0x08, 0x78, 0x64, 0x70, 0x46, 0x6c, 0x61, 0x67, 0x73, 0x12, 0x1f, 0x0a,
+	0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x18, 0x03, 0x20, 0x01,
+	0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x12, 0x1a,
+	0x0a, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x18, 0x04, 0x20, 0x01, 0x28, 0x0d,
+	0x52, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x22, 0x4d, 0x0a, 0x0e, 0x4c, 0x6f,
+	0x61, 0x64, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x12, 0x1f, 0x0a, 0x0b,
+	0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x18, 0x01, 0x20, 0x01, 0x28,
+	0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x12, 0x1a, 0x0a,
+	0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x18, 0x02, 0x20, 0x01, 0x28, 0x0d, 0x52,
+	0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x22, 0x50, 0x0a, 0x11, 0x55, 0x70, 0x67,
+	0x72, 0x61, 0x64, 0x65, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x12, 0x1f,
+	0x0a, 0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x18, 0x01, 0x20,
+	0x01, 0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f, 0x67, 0x72, 0x61, 0x6d, 0x12,
+	0x1a, 0x0a, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x18, 0x02, 0x20, 0x01, 0x28,
+	0x0d, 0x52, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73, 0x22, 0x48, 0x0a, 0x0f, 0x53,
+	0x74, 0x61, 0x67, 0x65, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x12, 0x14,
+	0x0a, 0x05, 0x73, 0x74, 0x61, 0x67, 0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x05, 0x73,
+	0x74, 0x61, 0x67, 0x65, 0x12, 0x1f, 0x0a, 0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67,
+	0x72, 0x61, 0x6d, 0x18, 0x02, 0x20, 0x01, 0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72,
+	0x6f, 0x67, 0x72, 0x61, 0x6d, 0x22, 0x1f, 0x0a, 0x07, 0x53, 0x74, 0x61, 0x67, 0x65, 0x49, 0x44,
+	0x12, 0x14, 0x0a, 0x05, 0x73, 0x74, 0x61, 0x67, 0x65, 0x18, 0x01, 0x20, 0x01, 0x28, 0x0d, 0x52,
+	0x05, 0x73, 0x74, 0x61, 0x67, 0x65, 0x22, 0x24, 0x0a, 0x0a, 0x4c, 0x6f, 0x61, 0x64, 0x53, 0x74,
+	0x61, 0x74, 0x75, 0x73, 0x12, 0x16, 0x0a, 0x06, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x18, 0x01,
+	0x20, 0x01, 0x28, 0x08, 0x52, 0x06, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x22, 0x44, 0x0a, 0x0c,
+	0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x12, 0x1a, 0x0a, 0x08,
+	0x61, 0x74, 0x74, 0x61, 0x63, 0x68, 0x65, 0x64, 0x18, 0x01, 0x20, 0x01, 0x28, 0x08, 0x52, 0x08,
+	0x61, 0x74, 0x74, 0x61, 0x63, 0x68, 0x65, 0x64, 0x12, 0x18, 0x0a, 0x07, 0x63, 0x68, 0x61, 0x69,
+	0x6e, 0x65, 0x64, 0x18, 0x02, 0x20, 0x01, 0x28, 0x08, 0x52, 0x07, 0x63, 0x68, 0x61, 0x69, 0x6e,
+	0x65, 0x64, 0x22, 0x64, 0x0a, 0x0d, 0x48, 0x6f, 0x70, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74,
+	0x65, 0x72, 0x73, 0x12, 0x1f, 0x0a, 0x0b, 0x62, 0x70, 0x66, 0x5f, 0x70, 0x72, 0x6f, 0x67, 0x72,
+	0x61, 0x6d, 0x18, 0x01, 0x20, 0x01, 0x28, 0x09, 0x52, 0x0a, 0x62, 0x70, 0x66, 0x50, 0x72, 0x6f,
+	0x67, 0x72, 0x61, 0x6d, 0x12, 0x1a, 0x0a, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73,
+	0x18, 0x02, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x08, 0x66, 0x65, 0x61, 0x74, 0x75, 0x72, 0x65, 0x73,
+	0x12, 0x16, 0x0a, 0x06, 0x72, 0x65, 0x70, 0x65, 0x61, 0x74, 0x18, 0x03, 0x20, 0x01, 0x28, 0x0d,
+	0x52, 0x06, 0x72, 0x65, 0x70, 0x65, 0x61, 0x74, 0x22, 0x39, 0x0a, 0x07, 0x48, 0x6f, 0x70, 0x43,
+	0x6f, 0x73, 0x74, 0x12, 0x14, 0x0a, 0x05, 0x61, 0x6c, 0x6f, 0x6e, 0x65, 0x18, 0x01, 0x20, 0x01,
+	0x28, 0x0d, 0x52, 0x05, 0x61, 0x6c, 0x6f, 0x6e, 0x65, 0x12, 0x18, 0x0a, 0x07, 0x63, 0x68, 0x61,
+	0x69, 0x6e, 0x65, 0x64, 0x18, 0x02, 0x20, 0x01, 0x28, 0x0d, 0x52, 0x07, 0x63, 0x68, 0x61, 0x69,
+	0x6e, 0x65, 0x64, 0x32, 0xfb, 0x0a, 0x0a, 0x05, 0x43, 0x61, 0x72, 0x6e, 0x78, 0x12, 0x30, 0x0a,
+	0x0d, 0x47, 0x65, 0x74, 0x4e, 0x62, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73, 0x12, 0x0c,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61,
+	0x70, 0x69, 0x2e, 0x4e, 0x62, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x73, 0x22, 0x00, 0x12,
+	0x24, 0x0a, 0x04, 0x50, 0x69, 0x6e, 0x67, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61,
+	0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62,
+	0x61, 0x67, 0x65, 0x22, 0x00, 0x12, 0x31, 0x0a, 0x0a, 0x47, 0x65, 0x74, 0x43, 0x6f, 0x75, 0x6e,
+	0x74, 0x65, 0x72, 0x12, 0x0e, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65,
+	0x72, 0x49, 0x44, 0x1a, 0x11, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65,
+	0x72, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x22, 0x00, 0x12, 0x39, 0x0a, 0x10, 0x47, 0x65, 0x74, 0x43,
+	0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x42, 0x79, 0x4e, 0x61, 0x6d, 0x65, 0x12, 0x10, 0x2e, 0x61,
+	0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x1a, 0x11,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x56, 0x61, 0x6c, 0x75,
+	0x65, 0x22, 0x00, 0x12, 0x28, 0x0a, 0x09, 0x47, 0x65, 0x74, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61,
+	0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0b,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x63, 0x68, 0x65, 0x6d, 0x61, 0x22, 0x00, 0x12, 0x33, 0x0a,
+	0x0f, 0x47, 0x65, 0x74, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x73,
+	0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x10,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x43, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x4c, 0x69, 0x73, 0x74,
+	0x22, 0x00, 0x12, 0x25, 0x0a, 0x08, 0x53, 0x6e, 0x61, 0x70, 0x73, 0x68, 0x6f, 0x74, 0x12, 0x0c,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x09, 0x2e, 0x61,
+	0x70, 0x69, 0x2e, 0x53, 0x6e, 0x61, 0x70, 0x22, 0x00, 0x12, 0x36, 0x0a, 0x0e, 0x53, 0x6e, 0x61,
+	0x70, 0x73, 0x68, 0x6f, 0x74, 0x53, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x12, 0x15, 0x2e, 0x61, 0x70,
+	0x69, 0x2e, 0x53, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65,
+	0x72, 0x73, 0x1a, 0x09, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x6e, 0x61, 0x70, 0x22, 0x00, 0x30,
+	0x01, 0x12, 0x31, 0x0a, 0x0e, 0x4d, 0x65, 0x72, 0x67, 0x65, 0x64, 0x53, 0x6e, 0x61, 0x70, 0x73,
+	0x68, 0x6f, 0x74, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67,
+	0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4d, 0x65, 0x72, 0x67, 0x65, 0x64, 0x53, 0x6e,
+	0x61, 0x70, 0x22, 0x00, 0x12, 0x42, 0x0a, 0x14, 0x4d, 0x65, 0x72, 0x67, 0x65, 0x64, 0x53, 0x6e,
+	0x61, 0x70, 0x73, 0x68, 0x6f, 0x74, 0x53, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x12, 0x15, 0x2e, 0x61,
+	0x70, 0x69, 0x2e, 0x53, 0x74, 0x72, 0x65, 0x61, 0x6d, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74,
+	0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4d, 0x65, 0x72, 0x67, 0x65, 0x64,
+	0x53, 0x6e, 0x61, 0x70, 0x22, 0x00, 0x30, 0x01, 0x12, 0x26, 0x0a, 0x08, 0x47, 0x65, 0x74, 0x52,
+	0x61, 0x74, 0x65, 0x73, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61,
+	0x67, 0x65, 0x1a, 0x0a, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x61, 0x74, 0x65, 0x73, 0x22, 0x00,
+	0x12, 0x31, 0x0a, 0x09, 0x47, 0x65, 0x74, 0x53, 0x6e, 0x69, 0x54, 0x6f, 0x70, 0x12, 0x15, 0x2e,
+	0x61, 0x70, 0x69, 0x2e, 0x53, 0x6e, 0x69, 0x54, 0x6f, 0x70, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65,
+	0x74, 0x65, 0x72, 0x73, 0x1a, 0x0b, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x6e, 0x69, 0x54, 0x6f,
+	0x70, 0x22, 0x00, 0x12, 0x31, 0x0a, 0x07, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x73, 0x12, 0x15,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x50, 0x61, 0x72, 0x61, 0x6d,
+	0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0b, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x61, 0x6d, 0x70,
+	0x6c, 0x65, 0x22, 0x00, 0x30, 0x01, 0x12, 0x26, 0x0a, 0x08, 0x47, 0x65, 0x74, 0x53, 0x74, 0x61,
+	0x74, 0x73, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65,
+	0x1a, 0x0a, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x74, 0x61, 0x74, 0x73, 0x22, 0x00, 0x12, 0x2e,
+	0x0a, 0x04, 0x4c, 0x6f, 0x61, 0x64, 0x12, 0x13, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4c, 0x6f, 0x61,
+	0x64, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61, 0x70,
+	0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x3d,
+	0x0a, 0x0d, 0x4c, 0x6f, 0x61, 0x64, 0x41, 0x6e, 0x64, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x12,
+	0x19, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4c, 0x6f, 0x61, 0x64, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68,
+	0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69,
+	0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x34, 0x0a,
+	0x07, 0x55, 0x70, 0x67, 0x72, 0x61, 0x64, 0x65, 0x12, 0x16, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x55,
+	0x70, 0x67, 0x72, 0x61, 0x64, 0x65, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73,
+	0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64,
+	0x65, 0x22, 0x00, 0x12, 0x34, 0x0a, 0x09, 0x50, 0x6c, 0x75, 0x67, 0x53, 0x74, 0x61, 0x67, 0x65,
+	0x12, 0x14, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53, 0x74, 0x61, 0x67, 0x65, 0x50, 0x61, 0x72, 0x61,
+	0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74,
+	0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x2e, 0x0a, 0x0b, 0x55, 0x6e, 0x70,
+	0x6c, 0x75, 0x67, 0x53, 0x74, 0x61, 0x67, 0x65, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x53,
+	0x74, 0x61, 0x67, 0x65, 0x49, 0x44, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74,
+	0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x29, 0x0a, 0x06, 0x55, 0x6e, 0x6c,
+	0x6f, 0x61, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67,
+	0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f,
+	0x64, 0x65, 0x22, 0x00, 0x12, 0x32, 0x0a, 0x06, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x12, 0x15,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d,
+	0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75,
+	0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x29, 0x0a, 0x06, 0x44, 0x65, 0x74, 0x61,
+	0x63, 0x68, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65,
+	0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64,
+	0x65, 0x22, 0x00, 0x12, 0x35, 0x0a, 0x0f, 0x4d, 0x65, 0x61, 0x73, 0x75, 0x72, 0x65, 0x43, 0x68,
+	0x61, 0x69, 0x6e, 0x48, 0x6f, 0x70, 0x12, 0x12, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x48, 0x6f, 0x70,
+	0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0c, 0x2e, 0x61, 0x70, 0x69,
+	0x2e, 0x48, 0x6f, 0x70, 0x43, 0x6f, 0x73, 0x74, 0x22, 0x00, 0x12, 0x2f, 0x0a, 0x0c, 0x41, 0x74,
+	0x74, 0x61, 0x63, 0x68, 0x45, 0x67, 0x72, 0x65, 0x73, 0x73, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69,
 	0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52,
-	0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x32, 0x0a, 0x06, 0x41,
-	0x74, 0x74, 0x61, 0x63, 0x68, 0x12, 0x15, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x41, 0x74, 0x74, 0x61,
-	0x63, 0x68, 0x50, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x73, 0x1a, 0x0f, 0x2e, 0x61,
-	0x70, 0x69, 0x2e, 0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12,
-	0x29, 0x0a, 0x06, 0x44, 0x65, 0x74, 0x61, 0x63, 0x68, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e,
-	0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x52, 0x65,
-	0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x2b, 0x0a, 0x08, 0x49, 0x73,
-	0x4c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72,
-	0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4c, 0x6f, 0x61, 0x64, 0x53,
-	0x74, 0x61, 0x74, 0x75, 0x73, 0x22, 0x00, 0x12, 0x2f, 0x0a, 0x0a, 0x49, 0x73, 0x41, 0x74, 0x74,
-	0x61, 0x63, 0x68, 0x65, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62,
-	0x61, 0x67, 0x65, 0x1a, 0x11, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68,
-	0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x22, 0x00, 0x42, 0x0b, 0x5a, 0x09, 0x63, 0x61, 0x72, 0x6e,
-	0x78, 0x2f, 0x61, 0x70, 0x69, 0x62, 0x06, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x33,
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x2f, 0x0a, 0x0c, 0x44,
+	0x65, 0x74, 0x61, 0x63, 0x68, 0x45, 0x67, 0x72, 0x65, 0x73, 0x73, 0x12, 0x0c, 0x2e, 0x61, 0x70,
+	0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e,
+	0x52, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x43, 0x6f, 0x64, 0x65, 0x22, 0x00, 0x12, 0x2b, 0x0a, 0x08,
+	0x49, 0x73, 0x4c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47,
+	0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x0f, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x4c, 0x6f, 0x61,
+	0x64, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x22, 0x00, 0x12, 0x2f, 0x0a, 0x0a, 0x49, 0x73, 0x41,
+	0x74, 0x74, 0x61, 0x63, 0x68, 0x65, 0x64, 0x12, 0x0c, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61,
+	0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x11, 0x2e, 0x61, 0x70, 0x69, 0x2e, 0x41, 0x74, 0x74, 0x61,
+	0x63, 0x68, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x22, 0x00, 0x12, 0x35, 0x0a, 0x10, 0x49, 0x73,
+	0x45, 0x67, 0x72, 0x65, 0x73, 0x73, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x65, 0x64, 0x12, 0x0c,
+	0x2e, 0x61, 0x70, 0x69, 0x2e, 0x47, 0x61, 0x72, 0x62, 0x61, 0x67, 0x65, 0x1a, 0x11, 0x2e, 0x61,
+	0x70, 0x69, 0x2e, 0x41, 0x74, 0x74, 0x61, 0x63, 0x68, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x22,
+	0x00, 0x42, 0x0b, 0x5a, 0x09, 0x63, 0x61, 0x72, 0x6e, 0x78, 0x2f, 0x61, 0x70, 0x69, 0x62, 0x06,
+	0x70, 0x72, 0x6f, 0x74, 0x6f, 0x33,
 }
 
 var (
@@ -757,7 +2147,7 @@ func file_api_carnx_proto_rawDescGZIP() []byte {
 	return file_api_carnx_proto_rawDescData
 }
 
-var file_api_carnx_proto_msgTypes = make([]protoimpl.MessageInfo, 14)
+var file_api_carnx_proto_msgTypes = make([]protoimpl.MessageInfo, 34)
 var file_api_carnx_proto_goTypes = []interface{}{
 	(*Garbage)(nil),              // 0: api.Garbage
 	(*ReturnCode)(nil),           // 1: api.ReturnCode
@@ -767,46 +2157,102 @@ var file_api_carnx_proto_goTypes = []interface{}{
 	(*CounterValue)(nil),         // 5: api.CounterValue
 	(*CounterList)(nil),          // 6: api.CounterList
 	(*Snap)(nil),                 // 7: api.Snap
-	(*AttachParameters)(nil),     // 8: api.AttachParameters
-	(*LoadAttachParameters)(nil), // 9: api.LoadAttachParameters
-	(*LoadParameters)(nil),       // 10: api.LoadParameters
-	(*LoadStatus)(nil),           // 11: api.LoadStatus
-	(*AttachStatus)(nil),         // 12: api.AttachStatus
-	nil,                          // 13: api.Snap.DataEntry
+	(*StreamParameters)(nil),     // 8: api.StreamParameters
+	(*SourceSnap)(nil),           // 9: api.SourceSnap
+	(*MergedSnap)(nil),           // 10: api.MergedSnap
+	(*SniTopParameters)(nil),     // 11: api.SniTopParameters
+	(*SniCount)(nil),             // 12: api.SniCount
+	(*SniTop)(nil),               // 13: api.SniTop
+	(*SampleParameters)(nil),     // 14: api.SampleParameters
+	(*Sample)(nil),               // 15: api.Sample
+	(*CounterInfo)(nil),          // 16: api.CounterInfo
+	(*Schema)(nil),               // 17: api.Schema
+	(*Rates)(nil),                // 18: api.Rates
+	(*RpcStats)(nil),             // 19: api.RpcStats
+	(*Stats)(nil),                // 20: api.Stats
+	(*AttachParameters)(nil),     // 21: api.AttachParameters
+	(*LoadAttachParameters)(nil), // 22: api.LoadAttachParameters
+	(*LoadParameters)(nil),       // 23: api.LoadParameters
+	(*UpgradeParameters)(nil),    // 24: api.UpgradeParameters
+	(*StageParameters)(nil),      // 25: api.StageParameters
+	(*StageID)(nil),              // 26: api.StageID
+	(*LoadStatus)(nil),           // 27: api.LoadStatus
+	(*AttachStatus)(nil),         // 28: api.AttachStatus
+	(*HopParameters)(nil),        // 29: api.HopParameters
+	(*HopCost)(nil),              // 30: api.HopCost
+	nil,                          // 31: api.Snap.DataEntry
+	nil,                          // 32: api.SourceSnap.DataEntry
+	nil,                          // 33: api.MergedSnap.TotalEntry
 }
 var file_api_carnx_proto_depIdxs = []int32{
-	13, // 0: api.Snap.data:type_name -> api.Snap.DataEntry
-	0,  // 1: api.Carnx.GetNbCounters:input_type -> api.Garbage
-	0,  // 2: api.Carnx.Ping:input_type -> api.Garbage
-	3,  // 3: api.Carnx.GetCounter:input_type -> api.CounterID
-	4,  // 4: api.Carnx.GetCounterByName:input_type -> api.CounterName
-	0,  // 5: api.Carnx.GetCounterNames:input_type -> api.Garbage
-	0,  // 6: api.Carnx.Snapshot:input_type -> api.Garbage
-	10, // 7: api.Carnx.Load:input_type -> api.LoadParameters
-	9,  // 8: api.Carnx.LoadAndAttach:input_type -> api.LoadAttachParameters
-	0,  // 9: api.Carnx.Unload:input_type -> api.Garbage
-	8,  // 10: api.Carnx.Attach:input_type -> api.AttachParameters
-	0,  // 11: api.Carnx.Detach:input_type -> api.Garbage
-	0,  // 12: api.Carnx.IsLoaded:input_type -> api.Garbage
-	0,  // 13: api.Carnx.IsAttached:input_type -> api.Garbage
-	2,  // 14: api.Carnx.GetNbCounters:output_type -> api.NbCounters
-	0,  // 15: api.Carnx.Ping:output_type -> api.Garbage
-	5,  // 16: api.Carnx.GetCounter:output_type -> api.CounterValue
-	5,  // 17: api.Carnx.GetCounterByName:output_type -> api.CounterValue
-	6,  // 18: api.Carnx.GetCounterNames:output_type -> api.CounterList
-	7,  // 19: api.Carnx.Snapshot:output_type -> api.Snap
-	1,  // 20: api.Carnx.Load:output_type -> api.ReturnCode
-	1,  // 21: api.Carnx.LoadAndAttach:output_type -> api.ReturnCode
-	1,  // 22: api.Carnx.Unload:output_type -> api.ReturnCode
-	1,  // 23: api.Carnx.Attach:output_type -> api.ReturnCode
-	1,  // 24: api.Carnx.Detach:output_type -> api.ReturnCode
-	11, // 25: api.Carnx.IsLoaded:output_type -> api.LoadStatus
-	12, // 26: api.Carnx.IsAttached:output_type -> api.AttachStatus
-	14, // [14:27] is the sub-list for method output_type
-	1,  // [1:14] is the sub-list for method input_type
-	1,  // [1:1] is the sub-list for extension type_name
-	1,  // [1:1] is the sub-list for extension extendee
-	0,  // [0:1] is the sub-list for field type_name
+	31, // 0: api.Snap.data:type_name -> api.Snap.DataEntry
+	32, // 1: api.SourceSnap.data:type_name -> api.SourceSnap.DataEntry
+	9,  // 2: api.MergedSnap.sources:type_name -> api.SourceSnap
+	33, // 3: api.MergedSnap.total:type_name -> api.MergedSnap.TotalEntry
+	12, // 4: api.SniTop.entries:type_name -> api.SniCount
+	16, // 5: api.Schema.counters:type_name -> api.CounterInfo
+	19, // 6: api.Stats.rpcs:type_name -> api.RpcStats
+	0,  // 7: api.Carnx.GetNbCounters:input_type -> api.Garbage
+	0,  // 8: api.Carnx.Ping:input_type -> api.Garbage
+	3,  // 9: api.Carnx.GetCounter:input_type -> api.CounterID
+	4,  // 10: api.Carnx.GetCounterByName:input_type -> api.CounterName
+	0,  // 11: api.Carnx.GetSchema:input_type -> api.Garbage
+	0,  // 12: api.Carnx.GetCounterNames:input_type -> api.Garbage
+	0,  // 13: api.Carnx.Snapshot:input_type -> api.Garbage
+	8,  // 14: api.Carnx.SnapshotStream:input_type -> api.StreamParameters
+	0,  // 15: api.Carnx.MergedSnapshot:input_type -> api.Garbage
+	8,  // 16: api.Carnx.MergedSnapshotStream:input_type -> api.StreamParameters
+	0,  // 17: api.Carnx.GetRates:input_type -> api.Garbage
+	11, // 18: api.Carnx.GetSniTop:input_type -> api.SniTopParameters
+	14, // 19: api.Carnx.Samples:input_type -> api.SampleParameters
+	0,  // 20: api.Carnx.GetStats:input_type -> api.Garbage
+	23, // 21: api.Carnx.Load:input_type -> api.LoadParameters
+	22, // 22: api.Carnx.LoadAndAttach:input_type -> api.LoadAttachParameters
+	24, // 23: api.Carnx.Upgrade:input_type -> api.UpgradeParameters
+	25, // 24: api.Carnx.PlugStage:input_type -> api.StageParameters
+	26, // 25: api.Carnx.UnplugStage:input_type -> api.StageID
+	0,  // 26: api.Carnx.Unload:input_type -> api.Garbage
+	21, // 27: api.Carnx.Attach:input_type -> api.AttachParameters
+	0,  // 28: api.Carnx.Detach:input_type -> api.Garbage
+	29, // 29: api.Carnx.MeasureChainHop:input_type -> api.HopParameters
+	0,  // 30: api.Carnx.AttachEgress:input_type -> api.Garbage
+	0,  // 31: api.Carnx.DetachEgress:input_type -> api.Garbage
+	0,  // 32: api.Carnx.IsLoaded:input_type -> api.Garbage
+	0,  // 33: api.Carnx.IsAttached:input_type -> api.Garbage
+	0,  // 34: api.Carnx.IsEgressAttached:input_type -> api.Garbage
+	2,  // 35: api.Carnx.GetNbCounters:output_type -> api.NbCounters
+	0,  // 36: api.Carnx.Ping:output_type -> api.Garbage
+	5,  // 37: api.Carnx.GetCounter:output_type -> api.CounterValue
+	5,  // 38: api.Carnx.GetCounterByName:output_type -> api.CounterValue
+	17, // 39: api.Carnx.GetSchema:output_type -> api.Schema
+	6,  // 40: api.Carnx.GetCounterNames:output_type -> api.CounterList
+	7,  // 41: api.Carnx.Snapshot:output_type -> api.Snap
+	7,  // 42: api.Carnx.SnapshotStream:output_type -> api.Snap
+	10, // 43: api.Carnx.MergedSnapshot:output_type -> api.MergedSnap
+	10, // 44: api.Carnx.MergedSnapshotStream:output_type -> api.MergedSnap
+	18, // 45: api.Carnx.GetRates:output_type -> api.Rates
+	13, // 46: api.Carnx.GetSniTop:output_type -> api.SniTop
+	15, // 47: api.Carnx.Samples:output_type -> api.Sample
+	20, // 48: api.Carnx.GetStats:output_type -> api.Stats
+	1,  // 49: api.Carnx.Load:output_type -> api.ReturnCode
+	1,  // 50: api.Carnx.LoadAndAttach:output_type -> api.ReturnCode
+	1,  // 51: api.Carnx.Upgrade:output_type -> api.ReturnCode
+	1,  // 52: api.Carnx.PlugStage:output_type -> api.ReturnCode
+	1,  // 53: api.Carnx.UnplugStage:output_type -> api.ReturnCode
+	1,  // 54: api.Carnx.Unload:output_type -> api.ReturnCode
+	1,  // 55: api.Carnx.Attach:output_type -> api.ReturnCode
+	1,  // 56: api.Carnx.Detach:output_type -> api.ReturnCode
+	30, // 57: api.Carnx.MeasureChainHop:output_type -> api.HopCost
+	1,  // 58: api.Carnx.AttachEgress:output_type -> api.ReturnCode
+	1,  // 59: api.Carnx.DetachEgress:output_type -> api.ReturnCode
+	27, // 60: api.Carnx.IsLoaded:output_type -> api.LoadStatus
+	28, // 61: api.Carnx.IsAttached:output_type -> api.AttachStatus
+	28, // 62: api.Carnx.IsEgressAttached:output_type -> api.AttachStatus
+	35, // [35:63] is the sub-list for method output_type
+	7,  // [7:35] is the sub-list for method input_type
+	7,  // [7:7] is the sub-list for extension type_name
+	7,  // [7:7] is the sub-list for extension extendee
+	0,  // [0:7] is the sub-list for field type_name
 }
 
 func init() { file_api_carnx_proto_init() }
@@ -827,8 +2273,104 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[1].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*ReturnCode); i {
+		file_api_carnx_proto_msgTypes[1].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*ReturnCode); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[2].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*NbCounters); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[3].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*CounterID); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[4].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*CounterName); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[5].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*CounterValue); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[6].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*CounterList); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[7].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*Snap); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[8].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*StreamParameters); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[9].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*SourceSnap); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -839,8 +2381,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[2].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*NbCounters); i {
+		file_api_carnx_proto_msgTypes[10].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*MergedSnap); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -851,8 +2393,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[3].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*CounterID); i {
+		file_api_carnx_proto_msgTypes[11].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*SniTopParameters); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -863,8 +2405,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[4].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*CounterName); i {
+		file_api_carnx_proto_msgTypes[12].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*SniCount); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -875,8 +2417,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[5].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*CounterValue); i {
+		file_api_carnx_proto_msgTypes[13].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*SniTop); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -887,8 +2429,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[6].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*CounterList); i {
+		file_api_carnx_proto_msgTypes[14].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*SampleParameters); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -899,8 +2441,8 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[7].Exporter = func(v interface{}, i int) interface{} {
-			switch v := v.(*Snap); i {
+		file_api_carnx_proto_msgTypes[15].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*Sample); i {
 			case 0:
 				return &v.state
 			case 1:
@@ -911,7 +2453,67 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[8].Exporter = func(v interface{}, i int) interface{} {
+		file_api_carnx_proto_msgTypes[16].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*CounterInfo); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[17].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*Schema); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[18].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*Rates); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[19].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*RpcStats); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[20].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*Stats); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[21].Exporter = func(v interface{}, i int) interface{} {
 			switch v := v.(*AttachParameters); i {
 			case 0:
 				return &v.state
@@ -923,7 +2525,7 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[9].Exporter = func(v interface{}, i int) interface{} {
+		file_api_carnx_proto_msgTypes[22].Exporter = func(v interface{}, i int) interface{} {
 			switch v := v.(*LoadAttachParameters); i {
 			case 0:
 				return &v.state
@@ -935,7 +2537,7 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[10].Exporter = func(v interface{}, i int) interface{} {
+		file_api_carnx_proto_msgTypes[23].Exporter = func(v interface{}, i int) interface{} {
 			switch v := v.(*LoadParameters); i {
 			case 0:
 				return &v.state
@@ -947,7 +2549,43 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[11].Exporter = func(v interface{}, i int) interface{} {
+		file_api_carnx_proto_msgTypes[24].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*UpgradeParameters); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[25].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*StageParameters); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[26].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*StageID); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[27].Exporter = func(v interface{}, i int) interface{} {
 			switch v := v.(*LoadStatus); i {
 			case 0:
 				return &v.state
@@ -959,7 +2597,7 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
-		file_api_carnx_proto_msgTypes[12].Exporter = func(v interface{}, i int) interface{} {
+		file_api_carnx_proto_msgTypes[28].Exporter = func(v interface{}, i int) interface{} {
 			switch v := v.(*AttachStatus); i {
 			case 0:
 				return &v.state
@@ -971,6 +2609,30 @@ func file_api_carnx_proto_init() {
 				return nil
 			}
 		}
+		file_api_carnx_proto_msgTypes[29].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*HopParameters); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
+		file_api_carnx_proto_msgTypes[30].Exporter = func(v interface{}, i int) interface{} {
+			switch v := v.(*HopCost); i {
+			case 0:
+				return &v.state
+			case 1:
+				return &v.sizeCache
+			case 2:
+				return &v.unknownFields
+			default:
+				return nil
+			}
+		}
 	}
 	type x struct{}
 	out := protoimpl.TypeBuilder{
@@ -978,7 +2640,7 @@ func file_api_carnx_proto_init() {
 			GoPackagePath: reflect.TypeOf(x{}).PkgPath(),
 			RawDescriptor: file_api_carnx_proto_rawDesc,
 			NumEnums:      0,
-			NumMessages:   14,
+			NumMessages:   34,
 			NumExtensions: 0,
 			NumServices:   1,
 		},
@@ -1012,26 +2674,72 @@ type CarnxClient interface {
 	GetCounter(ctx context.Context, in *CounterID, opts ...grpc.CallOption) (*CounterValue, error)
 	// GetCounterByName returns the value of a counter given its name
 	GetCounterByName(ctx context.Context, in *CounterName, opts ...grpc.CallOption) (*CounterValue, error)
-	// GetCounterNames returns the list of the counters (in the right order)
+	// GetSchema returns the metadata of all the counters
+	GetSchema(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Schema, error)
+	// GetCounterNames returns the list of the active counters (in the right order)
 	GetCounterNames(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*CounterList, error)
-	// Snapshot returns the current values of the counters
+	// Snapshot returns the current values of the counters. When the
+	// egress program is attached, the egress counters are prefixed by TX_
 	Snapshot(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Snap, error)
+	// SnapshotStream sends a snapshot periodically. It fails when
+	// no program is loaded
+	SnapshotStream(ctx context.Context, in *StreamParameters, opts ...grpc.CallOption) (Carnx_SnapshotStreamClient, error)
+	// MergedSnapshot returns the latest snapshots of the upstreams
+	// and their sum (carnxd --upstream). It never waits for them
+	MergedSnapshot(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*MergedSnap, error)
+	// MergedSnapshotStream sends the merged snapshot periodically
+	// (carnxd --upstream)
+	MergedSnapshotStream(ctx context.Context, in *StreamParameters, opts ...grpc.CallOption) (Carnx_MergedSnapshotStreamClient, error)
+	// GetRates returns the packet and bit rates estimated by the
+	// kernel program (moving averages over 100 ms buckets)
+	GetRates(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Rates, error)
+	// GetSniTop returns the most seen (hashed) TLS server names. The
+	// L7 or SNI counter group must be enabled
+	GetSniTop(ctx context.Context, in *SniTopParameters, opts ...grpc.CallOption) (*SniTop, error)
+	// Samples turns the packet sampling on and streams the headers
+	// of the sampled packets. The sampling is turned off when the
+	// stream ends. A single stream can be open at a time
+	Samples(ctx context.Context, in *SampleParameters, opts ...grpc.CallOption) (Carnx_SamplesClient, error)
+	// GetStats returns the internal measures of the daemon (the
+	// per-RPC and libcarnx measures require carnxd --stats)
+	GetStats(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Stats, error)
 	// Load an eBPF program into the kernel
 	Load(ctx context.Context, in *LoadParameters, opts ...grpc.CallOption) (*ReturnCode, error)
 	// LoadAndAttach aims to init the XDP program. It loads the program
 	// into the kernel and attach it to the given interface with
 	// the given flags
 	LoadAndAttach(ctx context.Context, in *LoadAttachParameters, opts ...grpc.CallOption) (*ReturnCode, error)
+	// Upgrade replaces the running eBPF program by a new one. The counters
+	// are kept and the program is swapped atomically on the interface
+	Upgrade(ctx context.Context, in *UpgradeParameters, opts ...grpc.CallOption) (*ReturnCode, error)
+	// PlugStage replaces a single stage of the parser pipeline
+	// without detaching the program
+	PlugStage(ctx context.Context, in *StageParameters, opts ...grpc.CallOption) (*ReturnCode, error)
+	// UnplugStage removes a stage plugged at runtime and restores
+	// the built-in one
+	UnplugStage(ctx context.Context, in *StageID, opts ...grpc.CallOption) (*ReturnCode, error)
 	// Unload the eBPF program from the kernel
 	Unload(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error)
-	// Attach the XDP program onto the given interface
+	// Attach the XDP program onto the given interface. With chain, the
+	// program already attached keeps running after carnx
 	Attach(ctx context.Context, in *AttachParameters, opts ...grpc.CallOption) (*ReturnCode, error)
-	// Detach the XDP program from the interface previously given
+	// Detach the XDP program from the interface previously given. In
+	// chaining mode, the program which was attached before is put back
 	Detach(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error)
+	// MeasureChainHop runs a test instance of the program with and
+	// without a chained program to measure the cost of the hop
+	MeasureChainHop(ctx context.Context, in *HopParameters, opts ...grpc.CallOption) (*HopCost, error)
+	// AttachEgress counts the outgoing packets of the interface
+	// too (TC egress hook). The XDP program must be attached
+	AttachEgress(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error)
+	// DetachEgress stops counting the outgoing packets
+	DetachEgress(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error)
 	// IsLoaded check if the program is loaded into the kernel
 	IsLoaded(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*LoadStatus, error)
 	// IsAttached check if the program is attached to the interface
 	IsAttached(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*AttachStatus, error)
+	// IsEgressAttached check if the outgoing packets are counted
+	IsEgressAttached(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*AttachStatus, error)
 }
 
 type carnxClient struct {
@@ -1078,6 +2786,15 @@ func (c *carnxClient) GetCounterByName(ctx context.Context, in *CounterName, opt
 	return out, nil
 }
 
+func (c *carnxClient) GetSchema(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Schema, error) {
+	out := new(Schema)
+	err := c.cc.Invoke(ctx, "/api.Carnx/GetSchema", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
 func (c *carnxClient) GetCounterNames(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*CounterList, error) {
 	out := new(CounterList)
 	err := c.cc.Invoke(ctx, "/api.Carnx/GetCounterNames", in, out, opts...)
@@ -1096,45 +2813,231 @@ func (c *carnxClient) Snapshot(ctx context.Context, in *Garbage, opts ...grpc.Ca
 	return out, nil
 }
 
+func (c *carnxClient) SnapshotStream(ctx context.Context, in *StreamParameters, opts ...grpc.CallOption) (Carnx_SnapshotStreamClient, error) {
+	stream, err := c.cc.NewStream(ctx, &_Carnx_serviceDesc.Streams[0], "/api.Carnx/SnapshotStream", opts...)
+	if err != nil {
+		return nil, err
+	}
+	x := &carnxSnapshotStreamClient{stream}
+	if err := x.ClientStream.SendMsg(in); err != nil {
+		return nil, err
+	}
+	if err := x.ClientStream.CloseSend(); err != nil {
+		return nil, err
+	}
+	return x, nil
+}
+
+type Carnx_SnapshotStreamClient interface {
+	Recv() (*Snap, error)
+	grpc.ClientStream
+}
+
+type carnxSnapshotStreamClient struct {
+	grpc.ClientStream
+}
+
+func (x *carnxSnapshotStreamClient) Recv() (*Snap, error) {
+	m := new(Snap)
+	if err := x.ClientStream.RecvMsg(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
+func (c *carnxClient) MergedSnapshot(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*MergedSnap, error) {
+	out := new(MergedSnap)
+	err := c.cc.Invoke(ctx, "/api.Carnx/MergedSnapshot", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) MergedSnapshotStream(ctx context.Context, in *StreamParameters, opts ...grpc.CallOption) (Carnx_MergedSnapshotStreamClient, error) {
+	stream, err := c.cc.NewStream(ctx, &_Carnx_serviceDesc.Streams[1], "/api.Carnx/MergedSnapshotStream", opts...)
+	if err != nil {
+		return nil, err
+	}
+	x := &carnxMergedSnapshotStreamClient{stream}
+	if err := x.ClientStream.SendMsg(in); err != nil {
+		return nil, err
+	}
+	if err := x.ClientStream.CloseSend(); err != nil {
+		return nil, err
+	}
+	return x, nil
+}
+
+type Carnx_MergedSnapshotStreamClient interface {
+	Recv() (*MergedSnap, error)
+	grpc.ClientStream
+}
+
+type carnxMergedSnapshotStreamClient struct {
+	grpc.ClientStream
+}
+
+func (x *carnxMergedSnapshotStreamClient) Recv() (*MergedSnap, error) {
+	m := new(MergedSnap)
+	if err := x.ClientStream.RecvMsg(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
+func (c *carnxClient) GetRates(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Rates, error) {
+	out := new(Rates)
+	err := c.cc.Invoke(ctx, "/api.Carnx/GetRates", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) GetSniTop(ctx context.Context, in *SniTopParameters, opts ...grpc.CallOption) (*SniTop, error) {
+	out := new(SniTop)
+	err := c.cc.Invoke(ctx, "/api.Carnx/GetSniTop", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) Samples(ctx context.Context, in *SampleParameters, opts ...grpc.CallOption) (Carnx_SamplesClient, error) {
+	stream, err := c.cc.NewStream(ctx, &_Carnx_serviceDesc.Streams[2], "/api.Carnx/Samples", opts...)
+	if err != nil {
+		return nil, err
+	}
+	x := &carnxSamplesClient{stream}
+	if err := x.ClientStream.SendMsg(in); err != nil {
+		return nil, err
+	}
+	if err := x.ClientStream.CloseSend(); err != nil {
+		return nil, err
+	}
+	return x, nil
+}
+
+type Carnx_SamplesClient interface {
+	Recv() (*Sample, error)
+	grpc.ClientStream
+}
+
+type carnxSamplesClient struct {
+	grpc.ClientStream
+}
+
+func (x *carnxSamplesClient) Recv() (*Sample, error) {
+	m := new(Sample)
+	if err := x.ClientStream.RecvMsg(m); err != nil {
+		return nil, err
+	}
+	return m, nil
+}
+
+func (c *carnxClient) GetStats(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*Stats, error) {
+	out := new(Stats)
+	err := c.cc.Invoke(ctx, "/api.Carnx/GetStats", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
 func (c *carnxClient) Load(ctx context.Context, in *LoadParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
 	out := new(ReturnCode)
-	err := c.cc.Invoke(ctx, "/api.Carnx/Load", in, out, opts...)
+	err := c.cc.Invoke(ctx, "/api.Carnx/Load", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) LoadAndAttach(ctx context.Context, in *LoadAttachParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/LoadAndAttach", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) Upgrade(ctx context.Context, in *UpgradeParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/Upgrade", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) PlugStage(ctx context.Context, in *StageParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/PlugStage", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) UnplugStage(ctx context.Context, in *StageID, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/UnplugStage", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) Unload(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/Unload", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
+func (c *carnxClient) Attach(ctx context.Context, in *AttachParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+	out := new(ReturnCode)
+	err := c.cc.Invoke(ctx, "/api.Carnx/Attach", in, out, opts...)
 	if err != nil {
 		return nil, err
 	}
 	return out, nil
 }
 
-func (c *carnxClient) LoadAndAttach(ctx context.Context, in *LoadAttachParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+func (c *carnxClient) Detach(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
 	out := new(ReturnCode)
-	err := c.cc.Invoke(ctx, "/api.Carnx/LoadAndAttach", in, out, opts...)
+	err := c.cc.Invoke(ctx, "/api.Carnx/Detach", in, out, opts...)
 	if err != nil {
 		return nil, err
 	}
 	return out, nil
 }
 
-func (c *carnxClient) Unload(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
-	out := new(ReturnCode)
-	err := c.cc.Invoke(ctx, "/api.Carnx/Unload", in, out, opts...)
+func (c *carnxClient) MeasureChainHop(ctx context.Context, in *HopParameters, opts ...grpc.CallOption) (*HopCost, error) {
+	out := new(HopCost)
+	err := c.cc.Invoke(ctx, "/api.Carnx/MeasureChainHop", in, out, opts...)
 	if err != nil {
 		return nil, err
 	}
 	return out, nil
 }
 
-func (c *carnxClient) Attach(ctx context.Context, in *AttachParameters, opts ...grpc.CallOption) (*ReturnCode, error) {
+func (c *carnxClient) AttachEgress(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
 	out := new(ReturnCode)
-	err := c.cc.Invoke(ctx, "/api.Carnx/Attach", in, out, opts...)
+	err := c.cc.Invoke(ctx, "/api.Carnx/AttachEgress", in, out, opts...)
 	if err != nil {
 		return nil, err
 	}
 	return out, nil
 }
 
-func (c *carnxClient) Detach(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
+func (c *carnxClient) DetachEgress(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*ReturnCode, error) {
 	out := new(ReturnCode)
-	err := c.cc.Invoke(ctx, "/api.Carnx/Detach", in, out, opts...)
+	err := c.cc.Invoke(ctx, "/api.Carnx/DetachEgress", in, out, opts...)
 	if err != nil {
 		return nil, err
 	}
@@ -1159,6 +3062,15 @@ func (c *carnxClient) IsAttached(ctx context.Context, in *Garbage, opts ...grpc.
 	return out, nil
 }
 
+func (c *carnxClient) IsEgressAttached(ctx context.Context, in *Garbage, opts ...grpc.CallOption) (*AttachStatus, error) {
+	out := new(AttachStatus)
+	err := c.cc.Invoke(ctx, "/api.Carnx/IsEgressAttached", in, out, opts...)
+	if err != nil {
+		return nil, err
+	}
+	return out, nil
+}
+
 // CarnxServer is the server API for Carnx service.
 type CarnxServer interface {
 	// GetNbCounters returns the number of counters
@@ -1169,26 +3081,72 @@ type CarnxServer interface {
 	GetCounter(context.Context, *CounterID) (*CounterValue, error)
 	// GetCounterByName returns the value of a counter given its name
 	GetCounterByName(context.Context, *CounterName) (*CounterValue, error)
-	// GetCounterNames returns the list of the counters (in the right order)
+	// GetSchema returns the metadata of all the counters
+	GetSchema(context.Context, *Garbage) (*Schema, error)
+	// GetCounterNames returns the list of the active counters (in the right order)
 	GetCounterNames(context.Context, *Garbage) (*CounterList, error)
-	// Snapshot returns the current values of the counters
+	// Snapshot returns the current values of the counters. When the
+	// egress program is attached, the egress counters are prefixed by TX_
 	Snapshot(context.Context, *Garbage) (*Snap, error)
+	// SnapshotStream sends a snapshot periodically. It fails when
+	// no program is loaded
+	SnapshotStream(*StreamParameters, Carnx_SnapshotStreamServer) error
+	// MergedSnapshot returns the latest snapshots of the upstreams
+	// and their sum (carnxd --upstream). It never waits for them
+	MergedSnapshot(context.Context, *Garbage) (*MergedSnap, error)
+	// MergedSnapshotStream sends the merged snapshot periodically
+	// (carnxd --upstream)
+	MergedSnapshotStream(*StreamParameters, Carnx_MergedSnapshotStreamServer) error
+	// GetRates returns the packet and bit rates estimated by the
+	// kernel program (moving averages over 100 ms buckets)
+	GetRates(context.Context, *Garbage) (*Rates, error)
+	// GetSniTop returns the most seen (hashed) TLS server names. The
+	// L7 or SNI counter group must be enabled
+	GetSniTop(context.Context, *SniTopParameters) (*SniTop, error)
+	// Samples turns the packet sampling on and streams the headers
+	// of the sampled packets. The sampling is turned off when the
+	// stream ends. A single stream can be open at a time
+	Samples(*SampleParameters, Carnx_SamplesServer) error
+	// GetStats returns the internal measures of the daemon (the
+	// per-RPC and libcarnx measures require carnxd --stats)
+	GetStats(context.Context, *Garbage) (*Stats, error)
 	// Load an eBPF program into the kernel
 	Load(context.Context, *LoadParameters) (*ReturnCode, error)
 	// LoadAndAttach aims to init the XDP program. It loads the program
 	// into the kernel and attach it to the given interface with
 	// the given flags
 	LoadAndAttach(context.Context, *LoadAttachParameters) (*ReturnCode, error)
+	// Upgrade replaces the running eBPF program by a new one. The counters
+	// are kept and the program is swapped atomically on the interface
+	Upgrade(context.Context, *UpgradeParameters) (*ReturnCode, error)
+	// PlugStage replaces a single stage of the parser pipeline
+	// without detaching the program
+	PlugStage(context.Context, *StageParameters) (*ReturnCode, error)
+	// UnplugStage removes a stage plugged at runtime and restores
+	// the built-in one
+	UnplugStage(context.Context, *StageID) (*ReturnCode, error)
 	// Unload the eBPF program from the kernel
 	Unload(context.Context, *Garbage) (*ReturnCode, error)
-	// Attach the XDP program onto the given interface
+	// Attach the XDP program onto the given interface. With chain, the
+	// program already attached keeps running after carnx
 	Attach(context.Context, *AttachParameters) (*ReturnCode, error)
-	// Detach the XDP program from the interface previously given
+	// Detach the XDP program from the interface previously given. In
+	// chaining mode, the program which was attached before is put back
 	Detach(context.Context, *Garbage) (*ReturnCode, error)
+	// MeasureChainHop runs a test instance of the program with and
+	// without a chained program to measure the cost of the hop
+	MeasureChainHop(context.Context, *HopParameters) (*HopCost, error)
+	// AttachEgress counts the outgoing packets of the interface
+	// too (TC egress hook). The XDP program must be attached
+	AttachEgress(context.Context, *Garbage) (*ReturnCode, error)
+	// DetachEgress stops counting the outgoing packets
+	DetachEgress(context.Context, *Garbage) (*ReturnCode, error)
 	// IsLoaded check if the program is loaded into the kernel
 	IsLoaded(context.Context, *Garbage) (*LoadStatus, error)
 	// IsAttached check if the program is attached to the interface
 	IsAttached(context.Context, *Garbage) (*AttachStatus, error)
+	// IsEgressAttached check if the outgoing packets are counted
+	IsEgressAttached(context.Context, *Garbage) (*AttachStatus, error)
 }
 
 // UnimplementedCarnxServer can be embedded to have forward compatible implementations.
@@ -1207,18 +3165,51 @@ func (*UnimplementedCarnxServer) GetCounter(context.Context, *CounterID) (*Count
 func (*UnimplementedCarnxServer) GetCounterByName(context.Context, *CounterName) (*CounterValue, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method GetCounterByName not implemented")
 }
+func (*UnimplementedCarnxServer) GetSchema(context.Context, *Garbage) (*Schema, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method GetSchema not implemented")
+}
 func (*UnimplementedCarnxServer) GetCounterNames(context.Context, *Garbage) (*CounterList, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method GetCounterNames not implemented")
 }
 func (*UnimplementedCarnxServer) Snapshot(context.Context, *Garbage) (*Snap, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method Snapshot not implemented")
 }
+func (*UnimplementedCarnxServer) SnapshotStream(*StreamParameters, Carnx_SnapshotStreamServer) error {
+	return status.Errorf(codes.Unimplemented, "method SnapshotStream not implemented")
+}
+func (*UnimplementedCarnxServer) MergedSnapshot(context.Context, *Garbage) (*MergedSnap, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method MergedSnapshot not implemented")
+}
+func (*UnimplementedCarnxServer) MergedSnapshotStream(*StreamParameters, Carnx_MergedSnapshotStreamServer) error {
+	return status.Errorf(codes.Unimplemented, "method MergedSnapshotStream not implemented")
+}
+func (*UnimplementedCarnxServer) GetRates(context.Context, *Garbage) (*Rates, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method GetRates not implemented")
+}
+func (*UnimplementedCarnxServer) GetSniTop(context.Context, *SniTopParameters) (*SniTop, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method GetSniTop not implemented")
+}
+func (*UnimplementedCarnxServer) Samples(*SampleParameters, Carnx_SamplesServer) error {
+	return status.Errorf(codes.Unimplemented, "method Samples not implemented")
+}
+func (*UnimplementedCarnxServer) GetStats(context.Context, *Garbage) (*Stats, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method GetStats not implemented")
+}
 func (*UnimplementedCarnxServer) Load(context.Context, *LoadParameters) (*ReturnCode, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method Load not implemented")
 }
 func (*UnimplementedCarnxServer) LoadAndAttach(context.Context, *LoadAttachParameters) (*ReturnCode, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method LoadAndAttach not implemented")
 }
+func (*UnimplementedCarnxServer) Upgrade(context.Context, *UpgradeParameters) (*ReturnCode, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method Upgrade not implemented")
+}
+func (*UnimplementedCarnxServer) PlugStage(context.Context, *StageParameters) (*ReturnCode, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method PlugStage not implemented")
+}
+func (*UnimplementedCarnxServer) UnplugStage(context.Context, *StageID) (*ReturnCode, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method UnplugStage not implemented")
+}
 func (*UnimplementedCarnxServer) Unload(context.Context, *Garbage) (*ReturnCode, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method Unload not implemented")
 }
@@ -1228,12 +3219,24 @@ func (*UnimplementedCarnxServer) Attach(context.Context, *AttachParameters) (*Re
 func (*UnimplementedCarnxServer) Detach(context.Context, *Garbage) (*ReturnCode, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method Detach not implemented")
 }
+func (*UnimplementedCarnxServer) MeasureChainHop(context.Context, *HopParameters) (*HopCost, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method MeasureChainHop not implemented")
+}
+func (*UnimplementedCarnxServer) AttachEgress(context.Context, *Garbage) (*ReturnCode, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method AttachEgress not implemented")
+}
+func (*UnimplementedCarnxServer) DetachEgress(context.Context, *Garbage) (*ReturnCode, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method DetachEgress not implemented")
+}
 func (*UnimplementedCarnxServer) IsLoaded(context.Context, *Garbage) (*LoadStatus, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method IsLoaded not implemented")
 }
 func (*UnimplementedCarnxServer) IsAttached(context.Context, *Garbage) (*AttachStatus, error) {
 	return nil, status.Errorf(codes.Unimplemented, "method IsAttached not implemented")
 }
+func (*UnimplementedCarnxServer) IsEgressAttached(context.Context, *Garbage) (*AttachStatus, error) {
+	return nil, status.Errorf(codes.Unimplemented, "method IsEgressAttached not implemented")
+}
 
 func RegisterCarnxServer(s *grpc.Server, srv CarnxServer) {
 	s.RegisterService(&_Carnx_serviceDesc, srv)
@@ -1311,6 +3314,24 @@ func _Carnx_GetCounterByName_Handler(srv interface{}, ctx context.Context, dec f
 	return interceptor(ctx, in, info, handler)
 }
 
+func _Carnx_GetSchema_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).GetSchema(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/GetSchema",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).GetSchema(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 func _Carnx_GetCounterNames_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
 	in := new(Garbage)
 	if err := dec(in); err != nil {
@@ -1347,6 +3368,141 @@ func _Carnx_Snapshot_Handler(srv interface{}, ctx context.Context, dec func(inte
 	return interceptor(ctx, in, info, handler)
 }
 
+func _Carnx_SnapshotStream_Handler(srv interface{}, stream grpc.ServerStream) error {
+	m := new(StreamParameters)
+	if err := stream.RecvMsg(m); err != nil {
+		return err
+	}
+	return srv.(CarnxServer).SnapshotStream(m, &carnxSnapshotStreamServer{stream})
+}
+
+type Carnx_SnapshotStreamServer interface {
+	Send(*Snap) error
+	grpc.ServerStream
+}
+
+type carnxSnapshotStreamServer struct {
+	grpc.ServerStream
+}
+
+func (x *carnxSnapshotStreamServer) Send(m *Snap) error {
+	return x.ServerStream.SendMsg(m)
+}
+
+func _Carnx_MergedSnapshot_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).MergedSnapshot(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/MergedSnapshot",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).MergedSnapshot(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_MergedSnapshotStream_Handler(srv interface{}, stream grpc.ServerStream) error {
+	m := new(StreamParameters)
+	if err := stream.RecvMsg(m); err != nil {
+		return err
+	}
+	return srv.(CarnxServer).MergedSnapshotStream(m, &carnxMergedSnapshotStreamServer{stream})
+}
+
+type Carnx_MergedSnapshotStreamServer interface {
+	Send(*MergedSnap) error
+	grpc.ServerStream
+}
+
+type carnxMergedSnapshotStreamServer struct {
+	grpc.ServerStream
+}
+
+func (x *carnxMergedSnapshotStreamServer) Send(m *MergedSnap) error {
+	return x.ServerStream.SendMsg(m)
+}
+
+func _Carnx_GetRates_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).GetRates(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/GetRates",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).GetRates(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_GetSniTop_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(SniTopParameters)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).GetSniTop(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/GetSniTop",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).GetSniTop(ctx, req.(*SniTopParameters))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_Samples_Handler(srv interface{}, stream grpc.ServerStream) error {
+	m := new(SampleParameters)
+	if err := stream.RecvMsg(m); err != nil {
+		return err
+	}
+	return srv.(CarnxServer).Samples(m, &carnxSamplesServer{stream})
+}
+
+type Carnx_SamplesServer interface {
+	Send(*Sample) error
+	grpc.ServerStream
+}
+
+type carnxSamplesServer struct {
+	grpc.ServerStream
+}
+
+func (x *carnxSamplesServer) Send(m *Sample) error {
+	return x.ServerStream.SendMsg(m)
+}
+
+func _Carnx_GetStats_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).GetStats(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/GetStats",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).GetStats(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 func _Carnx_Load_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
 	in := new(LoadParameters)
 	if err := dec(in); err != nil {
@@ -1383,6 +3539,60 @@ func _Carnx_LoadAndAttach_Handler(srv interface{}, ctx context.Context, dec func
 	return interceptor(ctx, in, info, handler)
 }
 
+func _Carnx_Upgrade_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(UpgradeParameters)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).Upgrade(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/Upgrade",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).Upgrade(ctx, req.(*UpgradeParameters))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_PlugStage_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(StageParameters)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).PlugStage(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/PlugStage",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).PlugStage(ctx, req.(*StageParameters))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_UnplugStage_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(StageID)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).UnplugStage(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/UnplugStage",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).UnplugStage(ctx, req.(*StageID))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 func _Carnx_Unload_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
 	in := new(Garbage)
 	if err := dec(in); err != nil {
@@ -1437,6 +3647,60 @@ func _Carnx_Detach_Handler(srv interface{}, ctx context.Context, dec func(interf
 	return interceptor(ctx, in, info, handler)
 }
 
+func _Carnx_MeasureChainHop_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(HopParameters)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).MeasureChainHop(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/MeasureChainHop",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).MeasureChainHop(ctx, req.(*HopParameters))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_AttachEgress_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).AttachEgress(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/AttachEgress",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).AttachEgress(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
+func _Carnx_DetachEgress_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).DetachEgress(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/DetachEgress",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).DetachEgress(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 func _Carnx_IsLoaded_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
 	in := new(Garbage)
 	if err := dec(in); err != nil {
@@ -1473,6 +3737,24 @@ func _Carnx_IsAttached_Handler(srv interface{}, ctx context.Context, dec func(in
 	return interceptor(ctx, in, info, handler)
 }
 
+func _Carnx_IsEgressAttached_Handler(srv interface{}, ctx context.Context, dec func(interface{}) error, interceptor grpc.UnaryServerInterceptor) (interface{}, error) {
+	in := new(Garbage)
+	if err := dec(in); err != nil {
+		return nil, err
+	}
+	if interceptor == nil {
+		return srv.(CarnxServer).IsEgressAttached(ctx, in)
+	}
+	info := &grpc.UnaryServerInfo{
+		Server:     srv,
+		FullMethod: "/api.Carnx/IsEgressAttached",
+	}
+	handler := func(ctx context.Context, req interface{}) (interface{}, error) {
+		return srv.(CarnxServer).IsEgressAttached(ctx, req.(*Garbage))
+	}
+	return interceptor(ctx, in, info, handler)
+}
+
 var _Carnx_serviceDesc = grpc.ServiceDesc{
 	ServiceName: "api.Carnx",
 	HandlerType: (*CarnxServer)(nil),
@@ -1493,6 +3775,10 @@ var _Carnx_serviceDesc = grpc.ServiceDesc{
 			MethodName: "GetCounterByName",
 			Handler:    _Carnx_GetCounterByName_Handler,
 		},
+		{
+			MethodName: "GetSchema",
+			Handler:    _Carnx_GetSchema_Handler,
+		},
 		{
 			MethodName: "GetCounterNames",
 			Handler:    _Carnx_GetCounterNames_Handler,
@@ -1501,6 +3787,22 @@ var _Carnx_serviceDesc = grpc.ServiceDesc{
 			MethodName: "Snapshot",
 			Handler:    _Carnx_Snapshot_Handler,
 		},
+		{
+			MethodName: "MergedSnapshot",
+			Handler:    _Carnx_MergedSnapshot_Handler,
+		},
+		{
+			MethodName: "GetRates",
+			Handler:    _Carnx_GetRates_Handler,
+		},
+		{
+			MethodName: "GetSniTop",
+			Handler:    _Carnx_GetSniTop_Handler,
+		},
+		{
+			MethodName: "GetStats",
+			Handler:    _Carnx_GetStats_Handler,
+		},
 		{
 			MethodName: "Load",
 			Handler:    _Carnx_Load_Handler,
@@ -1509,6 +3811,18 @@ var _Carnx_serviceDesc = grpc.ServiceDesc{
 			MethodName: "LoadAndAttach",
 			Handler:    _Carnx_LoadAndAttach_Handler,
 		},
+		{
+			MethodName: "Upgrade",
+			Handler:    _Carnx_Upgrade_Handler,
+		},
+		{
+			MethodName: "PlugStage",
+			Handler:    _Carnx_PlugStage_Handler,
+		},
+		{
+			MethodName: "UnplugStage",
+			Handler:    _Carnx_UnplugStage_Handler,
+		},
 		{
 			MethodName: "Unload",
 			Handler:    _Carnx_Unload_Handler,
@@ -1521,6 +3835,18 @@ var _Carnx_serviceDesc = grpc.ServiceDesc{
 			MethodName: "Detach",
 			Handler:    _Carnx_Detach_Handler,
 		},
+		{
+			MethodName: "MeasureChainHop",
+			Handler:    _Carnx_MeasureChainHop_Handler,
+		},
+		{
+			MethodName: "AttachEgress",
+			Handler:    _Carnx_AttachEgress_Handler,
+		},
+		{
+			MethodName: "DetachEgress",
+			Handler:    _Carnx_DetachEgress_Handler,
+		},
 		{
 			MethodName: "IsLoaded",
 			Handler:    _Carnx_IsLoaded_Handler,
@@ -1529,7 +3855,27 @@ var _Carnx_serviceDesc = grpc.ServiceDesc{
 			MethodName: "IsAttached",
 			Handler:    _Carnx_IsAttached_Handler,
 		},
+		{
+			MethodName: "IsEgressAttached",
+			Handler:    _Carnx_IsEgressAttached_Handler,
+		},
+	},
+	Streams: []grpc.StreamDesc{
+		{
+			StreamName:    "SnapshotStream",
+			Handler:       _Carnx_SnapshotStream_Handler,
+			ServerStreams: true,
+		},
+		{
+			StreamName:    "MergedSnapshotStream",
+			Handler:       _Carnx_MergedSnapshotStream_Handler,
+			ServerStreams: true,
+		},
+		{
+			StreamName:    "Samples",
+			Handler:       _Carnx_Samples_Handler,
+			ServerStreams: true,
+		},
 	},
-	Streams:  []grpc.StreamDesc{},
 	Metadata: "api/carnx.proto",
 }
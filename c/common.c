@@ -65,45 +65,38 @@ int nb_counters()
     return (int)__END_OF_COUNTERS__;
 }
 
+// Metadata of the counters (index: enum Counter)
+static const struct counter_info COUNTERS[__END_OF_COUNTERS__] = {
+#define COUNTER(name, group, type, unit) {#name, group, #type, #unit},
+#include "counters.def"
+#undef COUNTER
+};
+
+const struct counter_info *counter_info(int c)
+{
+    if (c < 0 || c >= __END_OF_COUNTERS__)
+        return NULL;
+    return &COUNTERS[c];
+}
+
 int reverse_lookup(int c, char *name)
 {
-    switch ((enum Counter)c)
-    {
-    case PKT:
-        strcpy(name, "PKT");
-        break;
-    case IP:
-        strcpy(name, "IP");
-        break;
-    case IP6:
-        strcpy(name, "IP6");
-        break;
-    case TCP:
-        strcpy(name, "TCP");
-        break;
-    case UDP:
-        strcpy(name, "UDP");
-        break;
-    case ICMP:
-        strcpy(name, "ICMP");
-        break;
-    case ICMP6:
-        strcpy(name, "ICMP6");
-        break;
-    case ARP:
-        strcpy(name, "ARP");
-        break;
-    case ACK:
-        strcpy(name, "ACK");
-        break;
-    case SYN:
-        strcpy(name, "SYN");
-        break;
-    // case NEWCOUNTER:
-    //      strcpy(name, "NEWCOUNTER");
-    //      break;
-    default:
+    const struct counter_info *info = counter_info(c);
+    if (info == NULL)
         return -1;
-    }
+    strcpy(name, info->name);
     return 0;
-}
\ No newline at end of file
+}
+
+unsigned int counter_feature(int c)
+{
+    const struct counter_info *info = counter_info(c);
+    if (info == NULL)
+        return 0;
+    return info->feature;
+}
+
+u32 schema_hash()
+{
+    return CARNX_SCHEMA_HASH;
+}
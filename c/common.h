@@ -17,6 +17,7 @@
 #include <linux/if_ether.h>
 #include <linux/ip.h>
 #include <linux/tcp.h>
+#include <linux/udp.h>
 #include <linux/types.h>
 
 #include <arpa/inet.h>
@@ -24,6 +25,7 @@
 
 // types
 typedef unsigned long u64;
+typedef long s64;
 typedef unsigned int u32;
 typedef unsigned short u16;
 typedef unsigned char u8;
@@ -35,7 +37,61 @@ typedef unsigned char u8;
 #define XDP_CARNX_MAP carnx_map
 #define XDP_CARNX_MAP_NAME "carnx_map"
 #define PIN_BASEDIR "/sys/fs/bpf/xdp"
-#define MAX_NB_COUNTERS 256
+// number of values of a block of counters (struct counters): the number
+// of counters rounded up to a cache line of values (8 u64), so that the
+// block of a CPU fills whole cache lines
+#define COUNTER_STRIDE ((__END_OF_COUNTERS__ + 7) & ~7)
+
+// identifier of the counter schema (counters.def), given at build
+// time by the Makefile (0: unknown, the compatibility is not checked)
+#ifndef CARNX_SCHEMA_HASH
+#define CARNX_SCHEMA_HASH 0
+#endif
+
+// egress program (TC clsact hook)
+#define XDP_CARNX_TC_SECTION "tc"
+#define TC_CARNX_HANDLE 0xCA4
+#define TC_CARNX_PRIORITY 1
+
+// parser pipeline
+#define XDP_CARNX_PROG_SECTION "prog"
+#define XDP_CARNX_PROG xdp_update_counters
+#define XDP_CARNX_PROG_NAME "xdp_update_counters"
+#define XDP_CARNX_STAGES carnx_stages
+#define XDP_CARNX_STAGES_NAME "carnx_stages"
+#define XDP_CARNX_SCRATCH carnx_scratch
+#define XDP_CARNX_SCRATCH_NAME "carnx_scratch"
+#define MAX_HDR_OFFSET 256
+
+// app-layer stage
+#define XDP_CARNX_SNI carnx_sni
+#define XDP_CARNX_SNI_NAME "carnx_sni"
+#define SNI_TABLE_SIZE 1024 // number of distinct (hashed) server names kept
+#define SNI_MAX_LENGTH 64   // bytes of the server name which are hashed
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+// chaining mode (program run after carnx)
+#define XDP_CARNX_CHAIN carnx_chain
+#define XDP_CARNX_CHAIN_NAME "carnx_chain"
+#define XDP_CARNX_PASS_SECTION "xdp/pass" // no-op program (hop measurement)
+
+// rate estimators
+#define XDP_CARNX_RATES carnx_rates
+#define XDP_CARNX_RATES_NAME "carnx_rates"
+#define RATE_BUCKET_NS 100000000UL // the estimates are updated once per bucket (100 ms)
+#define RATE_EWMA_SHIFT 2          // weight of the last bucket: 1/2^RATE_EWMA_SHIFT
+
+// packet sampling
+#define XDP_CARNX_SAMPLES carnx_samples
+#define XDP_CARNX_SAMPLES_NAME "carnx_samples"
+#define XDP_CARNX_SAMPLER carnx_sampler
+#define XDP_CARNX_SAMPLER_NAME "carnx_sampler"
+#define SAMPLES_RINGBUF_SIZE (256 * 1024) // bytes (power of 2, multiple of the page size)
+#define SAMPLE_HDR_LENGTH 128             // bytes of the packet which are exported
+
+// read-only section holding the load-time configuration
+#define XDP_CARNX_RODATA_SUFFIX ".rodata"
 
 // log constants
 #define __debug "\033[37;1mDEBUG\033[0m"
@@ -43,22 +99,141 @@ typedef unsigned char u8;
 #define __warn "\033[33;1mWARN\033[0m"
 #define __error "\033[31;1mERROR\033[0m"
 
-// Indices in the eBPF Map
+// Indices in the eBPF Map (generated from counters.def)
 enum Counter
 {
-    PKT,
-    IP,
-    IP6,
-    TCP,
-    UDP,
-    ICMP,
-    ICMP6,
-    ARP,
-    ACK,
-    SYN,
+#define COUNTER(name, group, type, unit) name,
+#include "counters.def"
+#undef COUNTER
     __END_OF_COUNTERS__, // aims to loop over the counters (it must be the last item)
 };
 
+// Direction of the packets (key of the counter map)
+enum Direction
+{
+    DIR_RX,                // ingress (XDP)
+    DIR_TX,                // egress (TC)
+    __END_OF_DIRECTIONS__, // it must be the last item
+};
+
+// Value of the counter map: all the counters of a direction (index:
+// enum Counter) in a single per-CPU value, so that they are contiguous
+// and read with a single lookup
+struct counters
+{
+    u64 values[COUNTER_STRIDE];
+};
+
+// Slots of the parser pipeline (the L2 stage is the
+// entrypoint, it then tail-calls the next stages)
+enum Stage
+{
+    STAGE_L3,
+    STAGE_L4,
+    STAGE_APP,         // optional app-layer analyzer
+    __END_OF_STAGES__, // it must be the last item
+};
+
+// Data passed from one stage to the next ones (per-CPU)
+struct parse_state
+{
+    u32 l3_offset;
+    u32 l4_offset;
+    u32 l7_offset;
+    u16 l3_proto; // ethernet type (host order)
+    u8 l4_proto;  // ip protocol
+    u8 __pad;
+    u16 sport; // source port (host order)
+    u16 dport; // destination port (host order)
+};
+
+// Rate estimator of a CPU (one per direction). The packets are
+// accumulated during a bucket, then the moving averages are updated
+struct rate
+{
+    u64 bucket_start; // ns (bpf_ktime_get_ns)
+    u64 packets;      // packets of the current bucket
+    u64 bytes;        // bytes of the current bucket
+    u64 pps;          // packets per second (EWMA)
+    u64 bps;          // bits per second (EWMA)
+};
+
+// Close the buckets of a rate estimator elapsed ns after the start of
+// the current one (elapsed >= RATE_BUCKET_NS): the pending packets all
+// belong to the first bucket (a later packet would have closed it) and
+// the following ones are empty (at most 63, the caller resets the
+// estimator after a longer idle period). The kernel program and the
+// library both use it, so they give the same estimates
+static inline void close_rate_buckets(s64 *pps, s64 *bps, u64 packets, u64 bytes, u64 elapsed)
+{
+    u64 missed = elapsed / RATE_BUCKET_NS - 1;
+    int i;
+
+    *pps += ((s64)(packets * 1000000000UL / RATE_BUCKET_NS) - *pps) >> RATE_EWMA_SHIFT;
+    *bps += ((s64)(bytes * 8000000000UL / RATE_BUCKET_NS) - *bps) >> RATE_EWMA_SHIFT;
+    for (i = 0; i < 63 && i < missed; i++)
+    {
+        *pps += (0 - *pps) >> RATE_EWMA_SHIFT;
+        *bps += (0 - *bps) >> RATE_EWMA_SHIFT;
+    }
+}
+
+// Indices in the sampler map (runtime settings of the sampling)
+enum Sampler
+{
+    SAMPLER_RATE,       // 1 packet out of N is exported (0: off)
+    SAMPLER_DROPPED,    // samples lost because the ring buffer was full
+    __END_OF_SAMPLER__, // it must be the last item
+};
+
+// Record written into the ring buffer for every sampled packet
+struct sample
+{
+    u64 timestamp; // ns (CLOCK_MONOTONIC in the kernel, CLOCK_REALTIME once read)
+    u32 ifindex;   // ingress interface
+    u32 cpu;       // cpu which processed the packet
+    u32 length;    // length of the packet
+    u32 cap_len;   // bytes copied into data
+    u16 l3_proto;  // ethernet type (host order)
+    u8 l4_proto;   // ip protocol (0 if not ipv4)
+    u8 __pad;
+    u32 __pad2;
+    u8 data[SAMPLE_HDR_LENGTH];
+};
+
+// Groups of counters which can be enabled at load time. The PKT counter
+// is always enabled (FEATURE_PKT alone is the cheapest program)
+enum Feature
+{
+    FEATURE_PKT = 1 << 0, // PKT
+    FEATURE_L2 = 1 << 1,  // IP, IP6, ARP (ethernet type)
+    FEATURE_L3 = 1 << 2,  // TCP, UDP, ICMP, ICMP6 (ip protocol)
+    FEATURE_L4 = 1 << 3,  // ACK, SYN (tcp flags)
+    FEATURE_L7 = 1 << 4,  // DNS_*, HTTP_*, TLS* (app-layer stage)
+    FEATURE_SNI = 1 << 5,   // hashed SNI table (app-layer stage)
+    FEATURE_RATES = 1 << 6, // pps/bps estimators
+    // groups enabled when none is given
+    FEATURE_DEFAULT = FEATURE_PKT | FEATURE_L2 | FEATURE_L3 | FEATURE_L4 | FEATURE_RATES,
+    FEATURE_ALL = FEATURE_DEFAULT | FEATURE_L7 | FEATURE_SNI,
+};
+
+// Load-time configuration of the kernel program. It is stored in
+// a read-only section so it is a constant for the verifier
+struct config
+{
+    u32 features;
+    u32 schema_hash; // CARNX_SCHEMA_HASH of the program
+};
+
+// Metadata of a counter (see counters.def)
+struct counter_info
+{
+    const char *name;
+    unsigned int feature; // group (enum Feature)
+    const char *type;
+    const char *unit;
+};
+
 // Activate/Desactivate debug log output
 void set_debug(int active);
 
@@ -80,4 +255,13 @@ int nb_counters();
 // reverse counter lookup (id -> name)
 int reverse_lookup(int c, char *name);
 
+// return the metadata of a counter (NULL if it does not exist)
+const struct counter_info *counter_info(int c);
+
+// return the group (enum Feature) the counter belongs to
+unsigned int counter_feature(int c);
+
+// return the identifier of the counter schema
+u32 schema_hash();
+
 #endif // _COMMON_H_
\ No newline at end of file
@@ -1,30 +1,115 @@
 // common
 #include "common.h"
+// tc actions
+#include <linux/pkt_cls.h>
 // helper functions (local)
 #include "libbpf/src/bpf_helpers.h"
 
-// Simple map to store the counters
+// Simple map to store the counters (one block
+// of counters per direction, see struct counters)
 struct bpf_map_def SEC("maps") XDP_CARNX_MAP = {
     .type = BPF_MAP_TYPE_PERCPU_ARRAY,
-    .key_size = sizeof(unsigned int), // counter_name
-    .value_size = sizeof(u64),        // counter_balue
-    .max_entries = MAX_NB_COUNTERS,   // number of keys
+    .key_size = sizeof(unsigned int),      // direction
+    .value_size = sizeof(struct counters), // counter values
+    .max_entries = __END_OF_DIRECTIONS__,  // number of keys
     .map_flags = 0,
 };
 
-static inline int increment_counter(int key)
+// Programs of the parser pipeline (index: enum Stage). Each
+// stage tail-calls the next one, so a slot can be swapped
+// at runtime without detaching the entrypoint
+struct bpf_map_def SEC("maps") XDP_CARNX_STAGES = {
+    .type = BPF_MAP_TYPE_PROG_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(u32),
+    .max_entries = __END_OF_STAGES__,
+    .map_flags = 0,
+};
+
+// Program the packets are handed to once counted (chaining mode). It
+// is the program which was attached to the interface before carnx, so
+// its verdict is the final one. The slot is empty otherwise
+struct bpf_map_def SEC("maps") XDP_CARNX_CHAIN = {
+    .type = BPF_MAP_TYPE_PROG_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(u32),
+    .max_entries = 1,
+    .map_flags = 0,
+};
+
+// Offsets parsed by the previous stages. The packet is processed
+// by a single CPU from the first to the last stage, so a per-CPU
+// slot is enough
+struct bpf_map_def SEC("maps") XDP_CARNX_SCRATCH = {
+    .type = BPF_MAP_TYPE_PERCPU_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(struct parse_state),
+    .max_entries = 1,
+    .map_flags = 0,
+};
+
+// Hashed server names (TLS SNI) -> number of ClientHello. Once
+// full, the least recently seen names are evicted, so the table
+// keeps the most active ones
+struct bpf_map_def SEC("maps") XDP_CARNX_SNI = {
+    .type = BPF_MAP_TYPE_LRU_PERCPU_HASH,
+    .key_size = sizeof(u32),   // FNV-1a hash of the server name
+    .value_size = sizeof(u64), // number of ClientHello
+    .max_entries = SNI_TABLE_SIZE,
+    .map_flags = 0,
+};
+
+// Sampled packet headers, read by the libcarnx consumer thread.
+// Records are written in place (bpf_ringbuf_reserve), so there
+// is no extra copy compared to a perf buffer
+struct bpf_map_def SEC("maps") XDP_CARNX_SAMPLES = {
+    .type = BPF_MAP_TYPE_RINGBUF,
+    .key_size = 0,
+    .value_size = 0,
+    .max_entries = SAMPLES_RINGBUF_SIZE,
+    .map_flags = 0,
+};
+
+// Runtime settings of the sampling (index: enum Sampler)
+struct bpf_map_def SEC("maps") XDP_CARNX_SAMPLER = {
+    .type = BPF_MAP_TYPE_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(u64),
+    .max_entries = __END_OF_SAMPLER__,
+    .map_flags = 0,
+};
+
+// Packet and bit rates of each CPU (index: enum Direction)
+struct bpf_map_def SEC("maps") XDP_CARNX_RATES = {
+    .type = BPF_MAP_TYPE_PERCPU_ARRAY,
+    .key_size = sizeof(u32),
+    .value_size = sizeof(struct rate),
+    .max_entries = __END_OF_DIRECTIONS__,
+    .map_flags = 0,
+};
+
+// Load-time configuration (overwritten by the loader). As it lives
+// in .rodata, the verifier knows the enabled groups and the JIT
+// does not emit the code of the disabled ones
+const volatile struct config CARNX_CONFIG = {
+    .features = FEATURE_ALL,
+    .schema_hash = CARNX_SCHEMA_HASH,
+};
+
+static inline int increment_counter(int dir, int key)
 {
-    int localkey = key;
-    u64 *count = bpf_map_lookup_elem(&carnx_map, &localkey);
-    if (count)
+    u32 localkey = dir;
+    struct counters *block = bpf_map_lookup_elem(&carnx_map, &localkey);
+    // the bound check is for the verifier (key is a constant)
+    if (block && (u32)key < COUNTER_STRIDE)
     {
-        *count += 1;
+        block->values[key] += 1;
         return 0;
     }
     return 1;
 }
 
-static inline int update_eth_based_counter(struct ethhdr *eth)
+static inline int update_eth_based_counter(int dir, struct ethhdr *eth)
 {
     int index;
     switch (htons(eth->h_proto))
@@ -42,10 +127,10 @@ static inline int update_eth_based_counter(struct ethhdr *eth)
     if (index < 0)
         return -1;
 
-    return increment_counter(index);
+    return increment_counter(dir, index);
 }
 
-static inline int update_ip_based_counter(struct iphdr *ip)
+static inline int update_ip_based_counter(int dir, struct iphdr *ip)
 {
     int index;
 
@@ -70,67 +155,610 @@ static inline int update_ip_based_counter(struct iphdr *ip)
     if (index < 0)
         return -1;
 
-    return increment_counter(index);
+    return increment_counter(dir, index);
 }
 
-static inline int update_tcp_based_counter(struct tcphdr *tcph)
+static inline int update_tcp_based_counter(int dir, struct tcphdr *tcph)
 {
     if (tcph->ack)
-        increment_counter(ACK);
+        increment_counter(dir, ACK);
     if (tcph->syn)
-        increment_counter(SYN);
+        increment_counter(dir, SYN);
     return 0;
 }
 
-SEC("prog")
-int xdp_update_counters(struct xdp_md *ctx)
+// Account the packet in the rate estimator of the CPU. The moving
+// averages are only updated when a bucket ends (not per packet)
+static __always_inline void update_rate(int dir, u64 len)
 {
-    void *end = (void *)(long)ctx->data_end;
-    void *data = (void *)(long)ctx->data;
-    u64 offset = 0;
+    u32 key = dir;
+    struct rate *r = bpf_map_lookup_elem(&carnx_rates, &key);
+    if (!r)
+        return;
 
-    // a packet is received
-    increment_counter(PKT);
+    u64 now = bpf_ktime_get_ns();
+    u64 elapsed = now - r->bucket_start;
 
-    struct ethhdr *eth = data;
-    offset += sizeof(struct ethhdr);
-    /* make sure the bytes you want to read are within 
-       the packet's range before reading them */
-    if (data + offset > end)
+    // first bucket of the CPU (or after a long idle period)
+    if (r->bucket_start == 0 || elapsed > (RATE_BUCKET_NS << 6))
+    {
+        r->bucket_start = now;
+        r->packets = 0;
+        r->bytes = 0;
+        r->pps = 0;
+        r->bps = 0;
+    }
+    else if (elapsed >= RATE_BUCKET_NS)
+    {
+        // the packet starts a new bucket: close the pending one
+        // and the empty ones (same estimates as get_rates)
+        s64 pps = r->pps;
+        s64 bps = r->bps;
+        close_rate_buckets(&pps, &bps, r->packets, r->bytes, elapsed);
+        r->pps = pps;
+        r->bps = bps;
+        r->bucket_start = now;
+        r->packets = 0;
+        r->bytes = 0;
+    }
+
+    r->packets += 1;
+    r->bytes += len;
+}
+
+static inline struct parse_state *get_parse_state()
+{
+    u32 key = 0;
+    return bpf_map_lookup_elem(&carnx_scratch, &key);
+}
+
+// Export the first bytes of 1 packet out of N (SAMPLER_RATE). When
+// the sampling is off, it costs a single array lookup
+static inline void sample_packet(struct xdp_md *ctx, void *data, void *end, struct ethhdr *eth)
+{
+    u32 key = SAMPLER_RATE;
+    u64 *rate = bpf_map_lookup_elem(&carnx_sampler, &key);
+    if (!rate || *rate == 0)
+        return;
+    if (*rate > 1 && bpf_get_prandom_u32() % *rate != 0)
+        return;
+
+    struct sample *s = bpf_ringbuf_reserve(&carnx_samples, sizeof(struct sample), 0);
+    if (!s)
+    {
+        key = SAMPLER_DROPPED;
+        u64 *dropped = bpf_map_lookup_elem(&carnx_sampler, &key);
+        if (dropped)
+            __sync_fetch_and_add(dropped, 1);
+        return;
+    }
+
+    s->timestamp = bpf_ktime_get_ns();
+    s->ifindex = ctx->ingress_ifindex;
+    s->cpu = bpf_get_smp_processor_id();
+    s->length = end - data;
+    s->l3_proto = htons(eth->h_proto);
+    s->l4_proto = 0;
+    s->__pad = 0;
+    s->__pad2 = 0;
+    if (s->l3_proto == ETH_P_IP)
+    {
+        struct iphdr *ip = (void *)(eth + 1);
+        if ((void *)(ip + 1) <= end)
+            s->l4_proto = ip->protocol;
+    }
+
+    u32 i;
+#pragma unroll
+    for (i = 0; i < SAMPLE_HDR_LENGTH; i++)
+    {
+        if (data + i + 1 > end)
+            break;
+        s->data[i] = *(u8 *)(data + i);
+    }
+    s->cap_len = i;
+    bpf_ringbuf_submit(s, 0);
+}
+
+// ========================================================================== //
+// APP-LAYER ANALYZERS ====================================================== //
+// ========================================================================== //
+// Only the first bytes of the payload are read and every
+// loop is bounded, so that the analyzers remain cheap
+
+#define DNS_PORT 53
+#define DNS_HEADER_SIZE 12
+#define DNS_MAX_LABELS 16
+#define DNS_QTYPE_A 1
+#define DNS_QTYPE_AAAA 28
+#define DNS_QTYPE_ANY 255
+
+#define TLS_CONTENT_HANDSHAKE 0x16
+#define TLS_CLIENT_HELLO 0x01
+#define TLS_MAX_SESSION_ID 32
+#define TLS_MAX_EXTENSIONS 16
+#define TLS_EXT_SERVER_NAME 0
+#define MAX_APP_OFFSET 1024
+
+static inline int update_dns_based_counter(int dir, void *data, void *end, u32 offset)
+{
+    u8 *hdr = data + offset;
+    u8 *label;
+    u16 qtype;
+    int i;
+
+    if ((void *)(hdr + DNS_HEADER_SIZE) > end)
+        return -1;
+
+    // QR bit
+    if (hdr[2] & 0x80)
+        return increment_counter(dir, DNS_RESPONSE);
+    increment_counter(dir, DNS_QUERY);
+
+    // skip the name of the first question (sequence of labels)
+    offset += DNS_HEADER_SIZE;
+#pragma unroll
+    for (i = 0; i < DNS_MAX_LABELS; i++)
+    {
+        label = data + offset;
+        if ((void *)(label + 1) > end)
+            return -1;
+        if (*label == 0)
+            break;
+        // compressed names are not expected in a question
+        if (*label & 0xC0)
+            return -1;
+        offset += *label + 1;
+        if (offset > MAX_APP_OFFSET)
+            return -1;
+    }
+    // the name is longer than expected: the type is out of reach
+    if (i == DNS_MAX_LABELS)
+        return -1;
+
+    label = data + offset + 1;
+    if ((void *)(label + 2) > end)
+        return -1;
+    qtype = (label[0] << 8) | label[1];
+
+    switch (qtype)
+    {
+    case DNS_QTYPE_A:
+        return increment_counter(dir, DNS_A);
+    case DNS_QTYPE_AAAA:
+        return increment_counter(dir, DNS_AAAA);
+    case DNS_QTYPE_ANY:
+        return increment_counter(dir, DNS_ANY);
+    default:
+        return increment_counter(dir, DNS_OTHER);
+    }
+}
+
+static inline int update_http_based_counter(int dir, void *data, void *end, u32 offset)
+{
+    u8 *p = data + offset;
+    if ((void *)(p + 4) > end)
+        return -1;
+
+    if (p[0] == 'G' && p[1] == 'E' && p[2] == 'T' && p[3] == ' ')
+        return increment_counter(dir, HTTP_GET);
+    if (p[0] == 'P' && p[1] == 'O' && p[2] == 'S' && p[3] == 'T')
+        return increment_counter(dir, HTTP_POST);
+    if ((p[0] == 'H' && p[1] == 'E' && p[2] == 'A' && p[3] == 'D') ||
+        (p[0] == 'P' && p[1] == 'U' && p[2] == 'T' && p[3] == ' ') ||
+        (p[0] == 'D' && p[1] == 'E' && p[2] == 'L' && p[3] == 'E') ||
+        (p[0] == 'O' && p[1] == 'P' && p[2] == 'T' && p[3] == 'I') ||
+        (p[0] == 'P' && p[1] == 'A' && p[2] == 'T' && p[3] == 'C') ||
+        (p[0] == 'C' && p[1] == 'O' && p[2] == 'N' && p[3] == 'N'))
+        return increment_counter(dir, HTTP_OTHER);
+    return -1;
+}
+
+// Hash the server name of a TLS ClientHello (payload at offset)
+// and count it in the SNI table
+static inline int update_sni_table(void *data, void *end, u32 offset)
+{
+    u8 *p;
+    u16 len;
+    u16 ext_type = 0xFFFF;
+    u32 hash = FNV_OFFSET_BASIS;
+    u64 one = 1;
+    u64 *count;
+    int i;
+
+    // record header (5) + handshake header (4) + version (2) + random (32)
+    offset += 43;
+    // (the offset is bounded before it is added to data)
+    if (offset > MAX_APP_OFFSET)
+        return -1;
+    p = data + offset;
+    if ((void *)(p + 1) > end || *p > TLS_MAX_SESSION_ID)
+        return -1;
+    offset += 1 + *p;
+
+    // cipher suites
+    if (offset > MAX_APP_OFFSET)
+        return -1;
+    p = data + offset;
+    if ((void *)(p + 2) > end)
+        return -1;
+    offset += 2 + ((p[0] << 8) | p[1]);
+
+    // compression methods
+    if (offset > MAX_APP_OFFSET)
+        return -1;
+    p = data + offset;
+    if ((void *)(p + 1) > end)
+        return -1;
+    offset += 1 + *p;
+
+    // extensions length
+    offset += 2;
+
+#pragma unroll
+    for (i = 0; i < TLS_MAX_EXTENSIONS; i++)
+    {
+        if (offset > MAX_APP_OFFSET)
+            return -1;
+        p = data + offset;
+        if ((void *)(p + 4) > end)
+            return -1;
+        ext_type = (p[0] << 8) | p[1];
+        len = (p[2] << 8) | p[3];
+        if (ext_type == TLS_EXT_SERVER_NAME)
+            break;
+        offset += 4 + len;
+    }
+    if (ext_type != TLS_EXT_SERVER_NAME)
+        return -1;
+
+    // extension header (4) + list length (2) + name type (1)
+    offset += 7;
+    if (offset > MAX_APP_OFFSET)
+        return -1;
+    p = data + offset;
+    if ((void *)(p + 2) > end)
+        return -1;
+    len = (p[0] << 8) | p[1];
+    offset += 2;
+
+    // FNV-1a over the first bytes of the name
+#pragma unroll
+    for (i = 0; i < SNI_MAX_LENGTH; i++)
+    {
+        p = data + offset + i;
+        if (i >= len || (void *)(p + 1) > end)
+            break;
+        hash ^= *p;
+        hash *= FNV_PRIME;
+    }
+
+    count = bpf_map_lookup_elem(&carnx_sni, &hash);
+    if (count)
     {
-        return XDP_ABORTED;
+        *count += 1;
+        return 0;
+    }
+    return bpf_map_update_elem(&carnx_sni, &hash, &one, BPF_NOEXIST);
+}
+
+static inline int update_tls_based_counter(int dir, void *data, void *end, u32 offset)
+{
+    u8 *p = data + offset;
+    // record header (5) + handshake type (1) + length (3) + version (2)
+    if ((void *)(p + 11) > end)
+        return -1;
+    if (p[0] != TLS_CONTENT_HANDSHAKE || p[1] != 0x03 || p[5] != TLS_CLIENT_HELLO)
+        return -1;
+
+    if (CARNX_CONFIG.features & FEATURE_L7)
+    {
+        increment_counter(dir, TLS_HELLO);
+        // legacy version (TLS 1.3 clients announce 1.2 here)
+        switch (p[10])
+        {
+        case 0x01:
+            increment_counter(dir, TLS10);
+            break;
+        case 0x02:
+            increment_counter(dir, TLS11);
+            break;
+        case 0x03:
+            increment_counter(dir, TLS12);
+            break;
+        }
     }
 
+    // the table keeps the names asked to this host: the
+    // ClientHello it sends itself (egress) are left out
+    if ((CARNX_CONFIG.features & FEATURE_SNI) && dir == DIR_RX)
+        update_sni_table(data, end, offset);
+    return 0;
+}
+
+// ========================================================================== //
+// PARSER =================================================================== //
+// ========================================================================== //
+// Each step parses a layer, updates its counters and fills the state for
+// the next one. They are shared by the XDP stages (ingress, one stage per
+// step) and the TC program (egress, all the steps in a row)
+
+// Result of a parsing step
+enum Parse
+{
+    PARSE_ABORT, // truncated header
+    PARSE_STOP,  // nothing more to count
+    PARSE_NEXT,  // go on with the next step
+};
+
+// L2 step (eth must be within the packet's range)
+static __always_inline int parse_l2(int dir, struct ethhdr *eth, struct parse_state *state)
+{
     // update counters using ethernet frame
-    update_eth_based_counter(eth);
+    if (CARNX_CONFIG.features & FEATURE_L2)
+        update_eth_based_counter(dir, eth);
+
+    // nothing more to count
+    if (!(CARNX_CONFIG.features & (FEATURE_L3 | FEATURE_L4 | FEATURE_L7 | FEATURE_SNI)))
+        return PARSE_STOP;
+
+    state->l3_offset = sizeof(struct ethhdr);
+    state->l3_proto = htons(eth->h_proto);
+    return PARSE_NEXT;
+}
+
+// L3 step
+static __always_inline int parse_l3(int dir, void *data, void *end, struct parse_state *state)
+{
+    u32 offset;
+
+    if (state->l3_proto != ETH_P_IP)
+        return PARSE_STOP;
+
+    // bound the offset for the verifier
+    offset = state->l3_offset;
+    if (offset > MAX_HDR_OFFSET)
+        return PARSE_STOP;
 
     struct iphdr *iph = data + offset;
-    offset += sizeof(struct iphdr);
     /* make sure the bytes you want to read are within 
        the packet's range before reading them */
-    if (data + offset > end)
-    {
-        return XDP_ABORTED;
-    }
+    if ((void *)(iph + 1) > end)
+        return PARSE_ABORT;
 
     // update counters using ip frame
-    update_ip_based_counter(iph);
+    if (CARNX_CONFIG.features & FEATURE_L3)
+        update_ip_based_counter(dir, iph);
 
-    if (iph->protocol == IPPROTO_TCP)
+    if (iph->ihl < 5)
+        return PARSE_STOP;
+    state->l4_offset = offset + iph->ihl * 4;
+    state->l4_proto = iph->protocol;
+    return PARSE_NEXT;
+}
+
+// L4 step
+static __always_inline int parse_l4(int dir, void *data, void *end, struct parse_state *state)
+{
+    u32 offset;
+
+    // bound the offset for the verifier
+    offset = state->l4_offset;
+    if (offset > MAX_HDR_OFFSET)
+        return PARSE_STOP;
+
+    if (state->l4_proto == IPPROTO_TCP)
     {
         struct tcphdr *tcph = data + offset;
-        offset += sizeof(struct tcphdr);
         /* make sure the bytes you want to read are within 
            the packet's range before reading them */
-        if (data + offset > end)
-        {
-            return XDP_ABORTED;
-        }
-        // update counters using ip frame
-        update_tcp_based_counter(tcph);
+        if ((void *)(tcph + 1) > end)
+            return PARSE_ABORT;
+        // update counters using tcp segment
+        if (CARNX_CONFIG.features & FEATURE_L4)
+            update_tcp_based_counter(dir, tcph);
+        state->l7_offset = offset + tcph->doff * 4;
+        state->sport = htons(tcph->source);
+        state->dport = htons(tcph->dest);
+        return PARSE_NEXT;
+    }
+    if (state->l4_proto == IPPROTO_UDP)
+    {
+        struct udphdr *udph = data + offset;
+        if ((void *)(udph + 1) > end)
+            return PARSE_ABORT;
+        state->l7_offset = offset + sizeof(struct udphdr);
+        state->sport = htons(udph->source);
+        state->dport = htons(udph->dest);
+        return PARSE_NEXT;
     }
+    return PARSE_STOP;
+}
+
+// App-layer step (DNS, HTTP, TLS)
+static __always_inline int parse_app(int dir, void *data, void *end, struct parse_state *state)
+{
+    u32 offset;
+
+    // bound the offset for the verifier
+    offset = state->l7_offset;
+    if (offset > MAX_HDR_OFFSET)
+        return PARSE_STOP;
+
+    if (state->l4_proto == IPPROTO_UDP)
+    {
+        if ((CARNX_CONFIG.features & FEATURE_L7) &&
+            (state->dport == DNS_PORT || state->sport == DNS_PORT))
+            update_dns_based_counter(dir, data, end, offset);
+        return PARSE_STOP;
+    }
+
+    // tcp: a ClientHello starts with a handshake record,
+    // otherwise look for an http request line
+    if (update_tls_based_counter(dir, data, end, offset) < 0 &&
+        (CARNX_CONFIG.features & FEATURE_L7))
+        update_http_based_counter(dir, data, end, offset);
+
+    return PARSE_STOP;
+}
+
+// ========================================================================== //
+// XDP PIPELINE (INGRESS) =================================================== //
+// ========================================================================== //
 
+// Hand the packet to the chained program (if any), which then
+// gives the verdict. Otherwise the packet gets the given one
+static __always_inline int xdp_handoff(struct xdp_md *ctx, int verdict)
+{
+    bpf_tail_call(ctx, &carnx_chain, 0);
+    return verdict;
+}
+
+// XDP verdict once the parsing stops
+static __always_inline int xdp_verdict(struct xdp_md *ctx, int result)
+{
+    return xdp_handoff(ctx, result == PARSE_ABORT ? XDP_ABORTED : XDP_PASS);
+}
+
+// L2 stage (entrypoint)
+SEC(XDP_CARNX_PROG_SECTION)
+int XDP_CARNX_PROG(struct xdp_md *ctx)
+{
+    void *end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+    struct parse_state l2_state = {0};
+    struct parse_state *state;
+    int dir = DIR_RX;
+    int r;
+
+    // a packet is received
+    increment_counter(dir, PKT);
+    if (CARNX_CONFIG.features & FEATURE_RATES)
+        update_rate(dir, end - data);
+
+    struct ethhdr *eth = data;
+    /* make sure the bytes you want to read are within 
+       the packet's range before reading them */
+    if ((void *)(eth + 1) > end)
+    {
+        return xdp_handoff(ctx, XDP_ABORTED);
+    }
+
+    // export the headers (runtime sampling)
+    sample_packet(ctx, data, end, eth);
+
+    // the scratch slot is only needed by the next stages
+    r = parse_l2(dir, eth, &l2_state);
+    if (r != PARSE_NEXT)
+        return xdp_verdict(ctx, r);
+    state = get_parse_state();
+    if (!state)
+        return xdp_handoff(ctx, XDP_PASS);
+    *state = l2_state;
+
+    bpf_tail_call(ctx, &carnx_stages, STAGE_L3);
+    // empty slot
+    return xdp_handoff(ctx, XDP_PASS);
+}
+
+// L3 stage
+SEC("xdp/l3")
+int xdp_l3_stage(struct xdp_md *ctx)
+{
+    void *end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+    struct parse_state *state;
+    int r;
+
+    state = get_parse_state();
+    if (!state)
+        return xdp_handoff(ctx, XDP_PASS);
+    r = parse_l3(DIR_RX, data, end, state);
+    if (r != PARSE_NEXT)
+        return xdp_verdict(ctx, r);
+
+    bpf_tail_call(ctx, &carnx_stages, STAGE_L4);
+    // empty slot
+    return xdp_handoff(ctx, XDP_PASS);
+}
+
+// L4 stage
+SEC("xdp/l4")
+int xdp_l4_stage(struct xdp_md *ctx)
+{
+    void *end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+    struct parse_state *state;
+    int r;
+
+    state = get_parse_state();
+    if (!state)
+        return xdp_handoff(ctx, XDP_PASS);
+    r = parse_l4(DIR_RX, data, end, state);
+    if (r != PARSE_NEXT)
+        return xdp_verdict(ctx, r);
+
+    bpf_tail_call(ctx, &carnx_stages, STAGE_APP);
+    // empty slot (no app-layer analyzer plugged)
+    return xdp_handoff(ctx, XDP_PASS);
+}
+
+// App-layer stage (DNS, HTTP, TLS)
+SEC("xdp/app")
+int xdp_app_stage(struct xdp_md *ctx)
+{
+    void *end = (void *)(long)ctx->data_end;
+    void *data = (void *)(long)ctx->data;
+    struct parse_state *state;
+
+    state = get_parse_state();
+    if (!state)
+        return xdp_handoff(ctx, XDP_PASS);
+    return xdp_verdict(ctx, parse_app(DIR_RX, data, end, state));
+}
+
+// No-op program. It is chained to a test instance of the pipeline
+// to measure the cost of the hop (see measure_chain_hop)
+SEC(XDP_CARNX_PASS_SECTION)
+int xdp_pass(struct xdp_md *ctx)
+{
     return XDP_PASS;
 }
 
+// ========================================================================== //
+// TC PROGRAM (EGRESS) ====================================================== //
+// ========================================================================== //
+
+// Egress counters (clsact egress hook). Program arrays cannot mix
+// program types, so the steps are run in a row instead of being
+// tail-called: the packet pays for the same parsing as on ingress.
+// The packet is never dropped
+SEC(XDP_CARNX_TC_SECTION)
+int tc_update_counters(struct __sk_buff *skb)
+{
+    void *end = (void *)(long)skb->data_end;
+    void *data = (void *)(long)skb->data;
+    struct parse_state state = {0};
+    int dir = DIR_TX;
+
+    // a packet is sent
+    increment_counter(dir, PKT);
+    if (CARNX_CONFIG.features & FEATURE_RATES)
+        update_rate(dir, skb->len);
+
+    struct ethhdr *eth = data;
+    if ((void *)(eth + 1) > end)
+        return TC_ACT_OK;
+
+    if (parse_l2(dir, eth, &state) != PARSE_NEXT)
+        return TC_ACT_OK;
+    if (parse_l3(dir, data, end, &state) != PARSE_NEXT)
+        return TC_ACT_OK;
+    if (parse_l4(dir, data, end, &state) != PARSE_NEXT)
+        return TC_ACT_OK;
+    if (CARNX_CONFIG.features & (FEATURE_L7 | FEATURE_SNI))
+        parse_app(dir, data, end, &state);
+    return TC_ACT_OK;
+}
+
 char __license[] SEC("license") = "GPL";
\ No newline at end of file
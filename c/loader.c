@@ -42,35 +42,329 @@ int prepare_pin_endpoints(char *iface, char *pin_dir, char *path_to_map)
     return 0;
 }
 
-// This function loads a BPF program (XDP) into the kernel. It fills a bpf_object
+// This function loads a BPF program (XDP) into the kernel with the default
+// counter groups (see load_specialized_bpf_program). It fills a bpf_object
 // and also returns the program file descriptor
 int _load_bpf_program(char *filename, struct bpf_object **obj, int *prog_fd)
 {
-    // Attributes for BPF program
-    struct bpf_prog_load_attr prog_load_attr = {
-        .prog_type = BPF_PROG_TYPE_XDP, // XDP program
-        .file = filename,               // Compiled BPF program
-    };
+    // the object holds XDP and TC programs, so they are
+    // typed one by one (not all as XDP)
+    *obj = load_specialized_bpf_program(filename, FEATURE_DEFAULT, NULL, true, prog_fd);
+    if (*obj == NULL)
+        return -1;
+    return 0;
+}
 
-    // load BPF program
-    int err = bpf_prog_load_xattr(&prog_load_attr, obj, prog_fd);
-    if (err < 0)
+struct bpf_object *load_bpf_program(char *filename, int *prog_fd)
+{
+    struct bpf_object *obj;
+    if (_load_bpf_program(filename, &obj, prog_fd) < 0)
+        return NULL;
+    return obj;
+}
+
+// Find the read-only data section (config) of an object
+static struct bpf_map *find_rodata_map(struct bpf_object *obj)
+{
+    struct bpf_map *map;
+    size_t suffix_len = strlen(XDP_CARNX_RODATA_SUFFIX);
+    bpf_object__for_each_map(map, obj)
     {
-        errorf("loader", "Error while loading BPF program: %d", strerror(-err));
-        return err;
+        const char *name = bpf_map__name(map);
+        size_t len = strlen(name);
+        if (len >= suffix_len && strcmp(name + len - suffix_len, XDP_CARNX_RODATA_SUFFIX) == 0)
+            return map;
+    }
+    return NULL;
+}
+
+// Check that the program has been built from the same counter
+// schema as the library (the counter map has the same layout)
+static int check_schema(struct bpf_map *rodata, char *filename)
+{
+    size_t size = 0;
+    const struct config *config = bpf_map__initial_value(rodata, &size);
+    if (config == NULL || size < sizeof(struct config))
+    {
+        warnf("loader", "No counter schema in '%s'", filename);
+        return 0;
+    }
+    if (config->schema_hash == 0 || CARNX_SCHEMA_HASH == 0 ||
+        config->schema_hash == CARNX_SCHEMA_HASH)
+        return 0;
+
+    errorf("loader", "Counter schema of '%s' (%u) differs from the library one (%u)",
+           filename, config->schema_hash, CARNX_SCHEMA_HASH);
+    return -1;
+}
+
+// Check the layout of the counter map of the object: its values must
+// be the blocks of counters of the library (struct counters). It returns
+// 0 if the layout is compatible, -1 otherwise
+static int check_layout(struct bpf_object *obj, char *filename)
+{
+    struct bpf_map *map = bpf_object__find_map_by_name(obj, XDP_CARNX_MAP_NAME);
+    if (map == NULL)
+    {
+        errorf("loader", "No counter map in '%s'", filename);
+        return -1;
+    }
+    if (bpf_map__value_size(map) != sizeof(struct counters))
+    {
+        errorf("loader", "Counter map of '%s' has %u-byte values (expected: %zu)",
+               filename, bpf_map__value_size(map), sizeof(struct counters));
+        return -1;
     }
-    infof("loader", "BPF program '%s' loaded", filename);
     return 0;
 }
 
-struct bpf_object *load_bpf_program(char *filename, int *prog_fd)
+// Section of the programs run by each stage of the pipeline
+// (index: enum Stage)
+static const char *stage_sections[__END_OF_STAGES__] = {
+    "xdp/l3",
+    "xdp/l4",
+    "xdp/app",
+};
+
+// Groups (enum Feature) a built-in stage is useful for (0: always
+// useful). The slot is left empty otherwise, so the packets do not
+// pay for it
+static const unsigned int stage_features[__END_OF_STAGES__] = {
+    0,
+    0,
+    FEATURE_L7 | FEATURE_SNI,
+};
+
+// Make the maps of obj use the maps of another object which have the
+// same name (internal sections like .rodata are skipped)
+static int reuse_maps(struct bpf_object *obj, struct bpf_object *from)
+{
+    struct bpf_map *map;
+    struct bpf_map *origin;
+    int err;
+    bpf_object__for_each_map(map, obj)
+    {
+        const char *name = bpf_map__name(map);
+        if (strchr(name, '.') != NULL)
+            continue;
+        origin = bpf_object__find_map_by_name(from, name);
+        if (!origin)
+            continue;
+        err = bpf_map__reuse_fd(map, bpf_map__fd(origin));
+        if (err)
+        {
+            errorf("loader", "Error while reusing map %s: %s", name, strerror(-err));
+            return err;
+        }
+        debugf("loader", "Map %s reused", name);
+    }
+    return 0;
+}
+
+// Return the program of obj which lives in the given
+// section (NULL if there is none)
+struct bpf_program *find_program_by_section(struct bpf_object *obj, const char *section)
+{
+    struct bpf_program *prog;
+    bpf_object__for_each_program(prog, obj)
+    {
+        if (strcmp(bpf_program__section_name(prog), section) == 0)
+            return prog;
+    }
+    return NULL;
+}
+
+// Put the programs of obj whose section is a known stage
+// into the pipeline (if the enabled groups need them)
+static int register_stages(struct bpf_object *obj, unsigned int features)
+{
+    struct bpf_program *prog;
+    int stage;
+    int err;
+    for (stage = 0; stage < __END_OF_STAGES__; stage++)
+    {
+        if (stage_features[stage] && !(stage_features[stage] & features))
+            continue;
+        prog = find_program_by_section(obj, stage_sections[stage]);
+        if (!prog)
+            continue;
+        err = set_stage_program(obj, stage, bpf_program__fd(prog));
+        if (err)
+            return err;
+    }
+    return 0;
+}
+
+// This function loads a BPF program (XDP) into the kernel with only the
+// given counter groups (see enum Feature) compiled in. If from is not NULL
+// the program uses the maps of this object (counters, pipeline...) instead
+// of creating new ones. If with_stages is true, the stages found in the
+// object are put into the pipeline. It returns the pointer to the
+// bpf_object (NULL if an error occured)
+struct bpf_object *load_specialized_bpf_program(char *filename, unsigned int features, struct bpf_object *from, bool with_stages, int *prog_fd)
 {
     struct bpf_object *obj;
-    if (_load_bpf_program(filename, &obj, prog_fd) < 0)
+    struct bpf_program *prog;
+    struct bpf_map *map;
+    struct config config = {
+        .features = features | FEATURE_PKT,
+        .schema_hash = CARNX_SCHEMA_HASH,
+    };
+    int err;
+
+    obj = bpf_object__open_file(filename, NULL);
+    err = libbpf_get_error(obj);
+    if (err)
+    {
+        errorf("loader", "Error while opening BPF program '%s': %s", filename, strerror(-err));
         return NULL;
+    }
+
+    // the config is frozen once loaded, so the verifier
+    // can prune the branches of the disabled counters
+    map = find_rodata_map(obj);
+    if (!map)
+    {
+        warnf("loader", "No configuration section in '%s'", filename);
+    }
+    else if (check_schema(map, filename))
+    {
+        bpf_object__close(obj);
+        return NULL;
+    }
+    else if ((err = bpf_map__set_initial_value(map, &config, sizeof(config))))
+    {
+        errorf("loader", "Error while setting the configuration: %s", strerror(-err));
+        bpf_object__close(obj);
+        return NULL;
+    }
+
+    if (check_layout(obj, filename))
+    {
+        bpf_object__close(obj);
+        return NULL;
+    }
+
+    // plug the existing maps before loading so that the
+    // kernel does not create fresh ones (counters are kept)
+    if (from != NULL && reuse_maps(obj, from))
+    {
+        bpf_object__close(obj);
+        return NULL;
+    }
+
+    // the egress program is a TC classifier, the others are XDP
+    bpf_object__for_each_program(prog, obj)
+    {
+        if (strcmp(bpf_program__section_name(prog), XDP_CARNX_TC_SECTION) == 0)
+            bpf_program__set_type(prog, BPF_PROG_TYPE_SCHED_CLS);
+        else
+            bpf_program__set_type(prog, BPF_PROG_TYPE_XDP);
+    }
+
+    err = bpf_object__load(obj);
+    if (err)
+    {
+        errorf("loader", "Error while loading BPF program: %s", strerror(-err));
+        bpf_object__close(obj);
+        return NULL;
+    }
+
+    // the XDP entrypoint (fallback to the first program
+    // for objects which only contain a stage)
+    prog = find_program_by_section(obj, XDP_CARNX_PROG_SECTION);
+    if (!prog)
+        prog = bpf_program__next(NULL, obj);
+    if (!prog)
+    {
+        errorf("loader", "No program found in '%s'", filename);
+        bpf_object__close(obj);
+        return NULL;
+    }
+    *prog_fd = bpf_program__fd(prog);
+
+    if (with_stages && register_stages(obj, config.features))
+    {
+        bpf_object__close(obj);
+        return NULL;
+    }
+    infof("loader", "BPF program '%s' loaded (features: 0x%x)", filename, config.features);
     return obj;
 }
 
+// Put a program in a slot of the pipeline of obj (enum Stage). The
+// previous program of the slot is replaced atomically
+int set_stage_program(struct bpf_object *obj, int stage, int prog_fd)
+{
+    int key = stage;
+    int map_fd = get_map_fd_from_name(obj, XDP_CARNX_STAGES_NAME);
+    if (map_fd < 0)
+        return -1;
+    if (stage < 0 || stage >= __END_OF_STAGES__)
+    {
+        errorf("loader", "Unknown stage %d", stage);
+        return -1;
+    }
+    int err = bpf_map_update_elem(map_fd, &key, &prog_fd, BPF_ANY);
+    if (err)
+    {
+        errorf("loader", "Error while setting stage %d: %s", stage, strerror(errno));
+        return err;
+    }
+    debugf("loader", "Stage %d set (program fd: %d)", stage, prog_fd);
+    return 0;
+}
+
+// Return the file descriptor of the program of obj which implements
+// the given stage, or its first program if no section matches
+int get_stage_program_fd(struct bpf_object *obj, int stage)
+{
+    struct bpf_program *prog = NULL;
+    if (stage >= 0 && stage < __END_OF_STAGES__)
+        prog = find_program_by_section(obj, stage_sections[stage]);
+    if (!prog)
+        prog = bpf_program__next(NULL, obj);
+    if (!prog)
+        return -1;
+    return bpf_program__fd(prog);
+}
+
+// Put back the built-in program of obj (if any) into a slot of its
+// pipeline. The slot is emptied if obj does not provide this stage
+// or if the enabled groups do not need it
+int reset_stage_program(struct bpf_object *obj, int stage, unsigned int features)
+{
+    struct bpf_program *prog;
+    if (stage < 0 || stage >= __END_OF_STAGES__)
+    {
+        errorf("loader", "Unknown stage %d", stage);
+        return -1;
+    }
+    if (stage_features[stage] && !(stage_features[stage] & features))
+        return clear_stage_program(obj, stage);
+    prog = find_program_by_section(obj, stage_sections[stage]);
+    if (!prog)
+        return clear_stage_program(obj, stage);
+    return set_stage_program(obj, stage, bpf_program__fd(prog));
+}
+
+// Empty a slot of the pipeline of obj (enum Stage). The packets
+// then stop at the previous stage
+int clear_stage_program(struct bpf_object *obj, int stage)
+{
+    int key = stage;
+    int map_fd = get_map_fd_from_name(obj, XDP_CARNX_STAGES_NAME);
+    if (map_fd < 0)
+        return -1;
+    if (bpf_map_delete_elem(map_fd, &key) && errno != ENOENT)
+    {
+        errorf("loader", "Error while clearing stage %d: %s", stage, strerror(errno));
+        return -1;
+    }
+    debugf("loader", "Stage %d cleared", stage);
+    return 0;
+}
+
 int unload_bpf_program(struct bpf_object *obj)
 {
     int err = bpf_object__unload(obj);
@@ -107,7 +401,25 @@ int attach_bpf_program(int prog_fd, char *iface, unsigned int xdp_flags)
         return -errno;
     }
 
-    err = bpf_set_link_xdp_fd(ifindex, prog_fd, xdp_flags);
+    // do not evict the program of someone else (see attach_chained)
+    err = bpf_set_link_xdp_fd(ifindex, prog_fd, xdp_flags | XDP_FLAGS_UPDATE_IF_NOEXIST);
+    if (err == -EBUSY)
+    {
+        // a carnx program left by a previous run (the XDP
+        // attachment outlives the process) is replaced
+        int old_fd = get_attached_program_fd(iface, xdp_flags);
+        if (old_fd > 0 && is_carnx_program(old_fd))
+        {
+            warnf("loader", "Replacing the carnx program left on '%s'", iface);
+            err = replace_bpf_program(prog_fd, old_fd, iface, xdp_flags);
+            close(old_fd);
+            return err;
+        }
+        if (old_fd > 0)
+            close(old_fd);
+        errorf("loader", "Another XDP program is attached to '%s' (use the chaining mode)", iface);
+        return -EBUSY;
+    }
     if (err < 0)
     {
         errno = -err;
@@ -118,6 +430,34 @@ int attach_bpf_program(int prog_fd, char *iface, unsigned int xdp_flags)
     return 0;
 }
 
+// Atomically replace the XDP program old_prog_fd attached on iface by
+// prog_fd (XDP_FLAGS_REPLACE). The operation fails if old_prog_fd is not
+// the program currently attached, so no other program can be overwritten.
+// There is no time window where the interface has no program
+int replace_bpf_program(int prog_fd, int old_prog_fd, char *iface, unsigned int xdp_flags)
+{
+    int err;
+    DECLARE_LIBBPF_OPTS(bpf_xdp_set_link_opts, opts, .old_fd = old_prog_fd);
+
+    // find if interface exists
+    int ifindex = if_nametoindex(iface);
+    if (!ifindex)
+    {
+        errorf("loader", "Interface %s not found (%s)", iface, strerror(errno));
+        return -errno;
+    }
+
+    err = bpf_set_link_xdp_fd_opts(ifindex, prog_fd, xdp_flags | XDP_FLAGS_REPLACE, &opts);
+    if (err < 0)
+    {
+        errno = -err;
+        errorf("loader", "Error while replacing XDP program on '%s': %s", iface, strerror(errno));
+        return err;
+    }
+    infof("loader", "BPF program replaced on '%s'", iface);
+    return 0;
+}
+
 int detach_bpf_program(char *iface, unsigned int xdp_flags)
 {
     int err;
@@ -140,6 +480,201 @@ int detach_bpf_program(char *iface, unsigned int xdp_flags)
     return 0;
 }
 
+// Remove the XDP program prog_fd from the interface. Nothing is done
+// if another program is attached (XDP_FLAGS_REPLACE)
+int detach_own_bpf_program(int prog_fd, char *iface, unsigned int xdp_flags)
+{
+    int err;
+    DECLARE_LIBBPF_OPTS(bpf_xdp_set_link_opts, opts, .old_fd = prog_fd);
+
+    // find if interface exists
+    int ifindex = if_nametoindex(iface);
+    if (!ifindex)
+    {
+        errorf("loader", "Interface %s not found (%s)", iface, strerror(errno));
+        return -errno;
+    }
+
+    err = bpf_set_link_xdp_fd_opts(ifindex, -1, xdp_flags | XDP_FLAGS_REPLACE, &opts);
+    if (err < 0)
+    {
+        errno = -err;
+        errorf("loader", "Error while detaching XDP program from '%s': %s", iface, strerror(errno));
+        return err;
+    }
+    infof("loader", "BPF program detached from '%s'", iface);
+    return 0;
+}
+
+// Return a file descriptor of the XDP program attached on iface
+// (0 if there is none, a negative value on error)
+int get_attached_program_fd(char *iface, unsigned int xdp_flags)
+{
+    unsigned int prog_id = 0;
+    int err;
+    // find if interface exists
+    int ifindex = if_nametoindex(iface);
+    if (!ifindex)
+    {
+        errorf("loader", "Interface %s not found (%s)", iface, strerror(errno));
+        return -errno;
+    }
+
+    err = bpf_get_link_xdp_id(ifindex, &prog_id, xdp_flags);
+    if (err < 0)
+    {
+        errno = -err;
+        errorf("loader", "Error while querying the XDP program of '%s': %s", iface, strerror(errno));
+        return err;
+    }
+    if (prog_id == 0)
+        return 0;
+
+    int prog_fd = bpf_prog_get_fd_by_id(prog_id);
+    if (prog_fd < 0)
+    {
+        errorf("loader", "Error while retrieving program %u: %s", prog_id, strerror(errno));
+        return -errno;
+    }
+    return prog_fd;
+}
+
+// Check whether prog_fd is the entrypoint of a carnx program (by
+// name, the object which loaded it may not exist anymore)
+bool is_carnx_program(int prog_fd)
+{
+    struct bpf_prog_info info = {0};
+    unsigned int len = sizeof(info);
+    if (bpf_obj_get_info_by_fd(prog_fd, &info, &len))
+        return false;
+    // the kernel keeps BPF_OBJ_NAME_LEN - 1 characters
+    return strncmp(info.name, XDP_CARNX_PROG_NAME, BPF_OBJ_NAME_LEN - 1) == 0;
+}
+
+// Hand the packets to prog_fd once they are counted by obj
+// (chaining mode). A negative prog_fd empties the slot
+int set_chain_program(struct bpf_object *obj, int prog_fd)
+{
+    int key = 0;
+    int err;
+    int map_fd = get_map_fd_from_name(obj, XDP_CARNX_CHAIN_NAME);
+    if (map_fd < 0)
+        return map_fd;
+
+    if (prog_fd < 0)
+        err = bpf_map_delete_elem(map_fd, &key);
+    else
+        err = bpf_map_update_elem(map_fd, &key, &prog_fd, BPF_ANY);
+    if (err && !(prog_fd < 0 && errno == ENOENT))
+    {
+        errorf("loader", "Error while setting the chained program: %s", strerror(errno));
+        return -errno;
+    }
+    return 0;
+}
+
+// Run prog_fd repeat times on a sample packet (BPF_PROG_TEST_RUN)
+// and give the average duration (in ns)
+int measure_bpf_program(int prog_fd, int repeat, unsigned int *duration)
+{
+    // ethernet + ipv4 + tcp SYN (no payload)
+    unsigned char pkt[54] = {0};
+    int err;
+
+    pkt[12] = 0x08; // ETH_P_IP
+    pkt[14] = 0x45; // version, ihl
+    pkt[17] = 40;   // total length
+    pkt[22] = 64;   // ttl
+    pkt[23] = IPPROTO_TCP;
+    pkt[46] = 0x50; // doff
+    pkt[47] = 0x02; // SYN
+
+    DECLARE_LIBBPF_OPTS(bpf_test_run_opts, opts, .data_in = pkt,
+                        .data_size_in = sizeof(pkt), .repeat = repeat);
+    err = bpf_prog_test_run_opts(prog_fd, &opts);
+    if (err)
+    {
+        errorf("loader", "Error while running the program: %s", strerror(errno));
+        return -errno;
+    }
+    *duration = opts.duration;
+    return 0;
+}
+
+// Return the file descriptor of the egress (TC) program
+// of obj, or -1 if it does not provide one
+int get_tc_program_fd(struct bpf_object *obj)
+{
+    struct bpf_program *prog = find_program_by_section(obj, XDP_CARNX_TC_SECTION);
+    if (!prog)
+        return -1;
+    return bpf_program__fd(prog);
+}
+
+// Attach a TC program on the egress hook of iface (the clsact qdisc is
+// created if needed). The carnx filter already attached (if any) is
+// replaced atomically, the filters of other programs are left untouched
+int attach_tc_program(int prog_fd, char *iface)
+{
+    int err;
+    // find if interface exists
+    int ifindex = if_nametoindex(iface);
+    if (!ifindex)
+    {
+        errorf("loader", "Interface %s not found (%s)", iface, strerror(errno));
+        return -errno;
+    }
+
+    DECLARE_LIBBPF_OPTS(bpf_tc_hook, hook, .ifindex = ifindex, .attach_point = BPF_TC_EGRESS);
+    DECLARE_LIBBPF_OPTS(bpf_tc_opts, opts, .prog_fd = prog_fd, .flags = BPF_TC_F_REPLACE,
+                        .handle = TC_CARNX_HANDLE, .priority = TC_CARNX_PRIORITY);
+
+    err = bpf_tc_hook_create(&hook);
+    if (err < 0 && err != -EEXIST)
+    {
+        errno = -err;
+        errorf("loader", "Error while creating the clsact qdisc on '%s': %s", iface, strerror(errno));
+        return err;
+    }
+
+    err = bpf_tc_attach(&hook, &opts);
+    if (err < 0)
+    {
+        errno = -err;
+        errorf("loader", "Error while attaching TC program to '%s': %s", iface, strerror(errno));
+        return err;
+    }
+    infof("loader", "BPF program attached to '%s' (egress)", iface);
+    return 0;
+}
+
+// Remove the carnx filter from the egress hook of iface. The clsact
+// qdisc is kept as other filters may use it
+int detach_tc_program(char *iface)
+{
+    int err;
+    // find if interface exists
+    int ifindex = if_nametoindex(iface);
+    if (!ifindex)
+    {
+        errorf("loader", "Interface %s not found (%s)", iface, strerror(errno));
+        return -errno;
+    }
+
+    DECLARE_LIBBPF_OPTS(bpf_tc_hook, hook, .ifindex = ifindex, .attach_point = BPF_TC_EGRESS);
+    DECLARE_LIBBPF_OPTS(bpf_tc_opts, opts, .handle = TC_CARNX_HANDLE, .priority = TC_CARNX_PRIORITY);
+
+    err = bpf_tc_detach(&hook, &opts);
+    if (err < 0)
+    {
+        errno = -err;
+        errorf("loader", "Error while detaching TC program from '%s': %s", iface, strerror(errno));
+        return err;
+    }
+    infof("loader", "BPF program detached from '%s' (egress)", iface);
+    return 0;
+}
+
 // Remove maps endpoints (on the filesystem) if they exist
 int unpin_maps_if_exist(struct bpf_object *obj, char *pin_dir, char *path_to_map)
 {
@@ -180,7 +715,7 @@ struct bpf_object *load_attach_pin(char *filename, char *iface, unsigned int xdp
     char path_to_map[PATH_MAX];
     char pin_dir[PATH_MAX];
 
-    // Load the kernel code
+    // Load the kernel code (and fill the parser pipeline)
     if (_load_bpf_program(filename, &obj, &prog_fd))
         return NULL;
 
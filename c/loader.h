@@ -1,4 +1,5 @@
 #include "libbpf/src/libbpf.h"
+#include "libbpf/src/bpf.h"
 #include "common.h"
 
 #ifndef _LOADER_H_
@@ -8,7 +9,8 @@
 // endpoint /sys/fs/bpf/xdp/<iface>/carnx_map
 int prepare_pin_endpoints(char *iface, char *pin_dir, char *path_to_map);
 
-// This function loads a BPF program (XDP) into the kernel. It fills a bpf_object
+// This function loads a BPF program (XDP) into the kernel with the default
+// counter groups (see load_specialized_bpf_program). It fills a bpf_object
 // and also returns the program file descriptor
 int _load_bpf_program(char *filename, struct bpf_object **obj, int *prog_fd);
 
@@ -16,6 +18,35 @@ int _load_bpf_program(char *filename, struct bpf_object **obj, int *prog_fd);
 // the pointer to the bpf_object (NULL is an error occured)
 struct bpf_object *load_bpf_program(char *filename, int *prog_fd);
 
+// This function loads a BPF program (XDP) into the kernel with only the
+// given counter groups (see enum Feature) compiled in. If from is not NULL
+// the program uses the maps of this object (counters, pipeline...) instead
+// of creating new ones. If with_stages is true, the stages found in the
+// object are put into the pipeline. It returns the pointer to the
+// bpf_object (NULL if an error occured)
+struct bpf_object *load_specialized_bpf_program(char *filename, unsigned int features, struct bpf_object *from, bool with_stages, int *prog_fd);
+
+// Return the program of obj which lives in the given
+// section (NULL if there is none)
+struct bpf_program *find_program_by_section(struct bpf_object *obj, const char *section);
+
+// Put a program in a slot of the pipeline of obj (enum Stage). The
+// previous program of the slot is replaced atomically
+int set_stage_program(struct bpf_object *obj, int stage, int prog_fd);
+
+// Return the file descriptor of the program of obj which implements
+// the given stage, or its first program if no section matches
+int get_stage_program_fd(struct bpf_object *obj, int stage);
+
+// Put back the built-in program of obj (if any) into a slot of its
+// pipeline. The slot is emptied if obj does not provide this stage
+// or if the enabled groups do not need it
+int reset_stage_program(struct bpf_object *obj, int stage, unsigned int features);
+
+// Empty a slot of the pipeline of obj (enum Stage). The packets
+// then stop at the previous stage
+int clear_stage_program(struct bpf_object *obj, int stage);
+
 // This function unloads a program from the kernel
 int unload_bpf_program(struct bpf_object *obj);
 
@@ -30,12 +61,54 @@ int unload_bpf_program(struct bpf_object *obj);
  *                          error should be returned. It also disables hardware offloads.
  *   XDP_FLAGS_HW_MODE		Hardware offload mode. The kernel code is re-verified and compiled 
  *                          to be run by the hardware firmware
+ * The program is never attached over another one (XDP_FLAGS_UPDATE_IF_NOEXIST):
+ * it returns -EBUSY if the interface already has a program, unless it is a
+ * carnx program (left by a previous run) which is then replaced
  */
 int attach_bpf_program(int prog_fd, char *iface, unsigned int xdp_flags);
 
+// Atomically replace the XDP program old_prog_fd attached on iface by
+// prog_fd (XDP_FLAGS_REPLACE). The operation fails if old_prog_fd is not
+// the program currently attached, so no other program can be overwritten.
+// There is no time window where the interface has no program
+int replace_bpf_program(int prog_fd, int old_prog_fd, char *iface, unsigned int xdp_flags);
+
 // Remove all XDP programs from the interface
 int detach_bpf_program(char *iface, unsigned int xdp_flags);
 
+// Remove the XDP program prog_fd from the interface. Nothing is done
+// if another program is attached (XDP_FLAGS_REPLACE)
+int detach_own_bpf_program(int prog_fd, char *iface, unsigned int xdp_flags);
+
+// Return a file descriptor of the XDP program attached on iface
+// (0 if there is none, a negative value on error)
+int get_attached_program_fd(char *iface, unsigned int xdp_flags);
+
+// Check whether prog_fd is the entrypoint of a carnx program (by
+// name, the object which loaded it may not exist anymore)
+bool is_carnx_program(int prog_fd);
+
+// Hand the packets to prog_fd once they are counted by obj
+// (chaining mode). A negative prog_fd empties the slot
+int set_chain_program(struct bpf_object *obj, int prog_fd);
+
+// Run prog_fd repeat times on a sample packet (BPF_PROG_TEST_RUN)
+// and give the average duration (in ns)
+int measure_bpf_program(int prog_fd, int repeat, unsigned int *duration);
+
+// Return the file descriptor of the egress (TC) program
+// of obj, or -1 if it does not provide one
+int get_tc_program_fd(struct bpf_object *obj);
+
+// Attach a TC program on the egress hook of iface (the clsact qdisc is
+// created if needed). The carnx filter already attached (if any) is
+// replaced atomically, the filters of other programs are left untouched
+int attach_tc_program(int prog_fd, char *iface);
+
+// Remove the carnx filter from the egress hook of iface. The clsact
+// qdisc is kept as other filters may use it
+int detach_tc_program(char *iface);
+
 // Remove maps endpoints (on the filesystem) if they exist
 int unpin_maps_if_exist(struct bpf_object *obj, char *pin_dir, char *path_to_map);
 
@@ -0,0 +1,49 @@
+#!/bin/sh
+#
+# Build-time generation from the counter schema (counters.def)
+#   schema.sh hash   print the schema hash (CRC of the map layout
+#                    version and of the COUNTER lines)
+#   schema.sh go     print the Go lookup structures (counters.go)
+#
+
+DIR="$(dirname "$0")"
+DEF="${DIR}/counters.def"
+# version of the layout of the counter map (bump it when the key or the
+# value of carnx_map changes). 2: one struct counters per direction
+LAYOUT=2
+
+schema_hash() {
+    {
+        echo "LAYOUT ${LAYOUT}"
+        grep '^COUNTER(' "${DEF}"
+    } | cksum | cut -d' ' -f1
+}
+
+case "$1" in
+hash)
+    schema_hash
+    ;;
+go)
+    echo "// Code generated by c/schema.sh from c/counters.def. DO NOT EDIT."
+    echo
+    echo "package main"
+    echo
+    echo "// schemaHash identifies the counter schema (see C.schema_hash)"
+    echo "const schemaHash = $(schema_hash)"
+    echo
+    echo "// counterNames gives the name of the counters (index: enum Counter)"
+    echo "var counterNames = []string{"
+    grep '^COUNTER(' "${DEF}" | sed -e 's/^COUNTER(\([A-Za-z0-9_]*\),.*$/\t"\1",/'
+    echo "}"
+    echo
+    echo "// lookUp returns the key given the name of the counter"
+    echo "var lookUp = map[string]int{"
+    grep '^COUNTER(' "${DEF}" | sed -e 's/^COUNTER(\([A-Za-z0-9_]*\),.*$/\1/' |
+        awk '{ printf "\t\"%s\": %d,\n", $1, NR - 1 }'
+    echo "}"
+    ;;
+*)
+    echo "usage: $0 hash|go" >&2
+    exit 1
+    ;;
+esac
@@ -10,10 +10,16 @@ struct context CONTEXT = {
     .obj = NULL,
     .prog_fd = 0,
     .xdp_flags = 0,
+    .features = FEATURE_DEFAULT,
     .iface = {0},
     .map_fd = 0,
     .is_loaded = false,
     .is_attached = false,
+    .is_egress_attached = false,
+    .is_chained = false,
+    .chained_fd = -1,
+    .stages = {NULL},
+    .stage_fds = {0},
 };
 
 // last timestamp
@@ -25,6 +31,37 @@ struct timespec last_timestamp = {
 // period
 int period = 1;
 
+// failed lookups of the counter map
+u64 map_read_errors = 0;
+
+// Consumer of the sampled packets
+struct sampler
+{
+    struct ring_buffer *rb;
+    int map_fd; // own copy of the ring buffer fd (it survives upgrades)
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t ready;
+    bool running;
+    u64 clock_offset; // CLOCK_REALTIME - CLOCK_MONOTONIC (ns)
+    // samples not read yet (circular buffer)
+    struct sample queue[SAMPLE_QUEUE_SIZE];
+    unsigned int head;
+    unsigned int count;
+    u64 overflow; // samples lost because the queue was full
+};
+
+struct sampler SAMPLER = {
+    .rb = NULL,
+    .map_fd = -1,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .ready = PTHREAD_COND_INITIALIZER,
+    .running = false,
+    .head = 0,
+    .count = 0,
+    .overflow = 0,
+};
+
 // ========================================================================== //
 // ROUTINES ================================================================= //
 // ========================================================================== //
@@ -34,11 +71,26 @@ void debug_context()
     debugf("user", "BPF fd: %d, Map fd: %d", CONTEXT.prog_fd, CONTEXT.map_fd);
 }
 
-// Load an eBPF program into the kernel
-int load(char *filename)
+// Keep the enabled counter groups (0 means the default ones)
+static unsigned int normalize_features(unsigned int features)
 {
+    if (features == 0)
+        return FEATURE_DEFAULT;
+    return (features & FEATURE_ALL) | FEATURE_PKT;
+}
+
+// Load an eBPF program into the kernel with the given counter
+// groups (see enum Feature). If a program is already loaded,
+// it is upgraded in place (see upgrade)
+int load(char *filename, unsigned int features)
+{
+    // do not reload a second object on top of the running one
+    if (CONTEXT.is_loaded)
+        return upgrade(filename, features) < 0 ? -1 : 0;
+
+    features = normalize_features(features);
     // load and return the object
-    CONTEXT.obj = load_bpf_program(filename, &CONTEXT.prog_fd);
+    CONTEXT.obj = load_specialized_bpf_program(filename, features, NULL, true, &CONTEXT.prog_fd);
     if (CONTEXT.obj == NULL)
     {
         errorf("user", "Error while loading BPF program %s", filename);
@@ -46,6 +98,7 @@ int load(char *filename)
     }
     // set flag
     CONTEXT.is_loaded = true;
+    CONTEXT.features = features;
 
     // Get back the map
     CONTEXT.map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_MAP_NAME);
@@ -57,7 +110,12 @@ int load(char *filename)
     return 0;
 }
 
-// Attach the XDP program on the interface with given xdp_flags
+// Attach the XDP program on the interface with given xdp_flags. It
+// does not replace a program already attached (see attach_chained)
+// It returns a negative integer when an error occured
+// -1: The program is not loaded
+// -2: Another XDP program is attached to the interface
+// -3: Error while attaching program
 int attach(char *iface, unsigned int xdp_flags)
 {
     if (CONTEXT.obj == NULL)
@@ -70,8 +128,10 @@ int attach(char *iface, unsigned int xdp_flags)
 
     // attach
     int r = attach_bpf_program(CONTEXT.prog_fd, iface, xdp_flags);
+    if (r == -EBUSY)
+        return -2;
     if (r < 0)
-        return r;
+        return -3;
 
     // update context
     CONTEXT.xdp_flags = xdp_flags;
@@ -80,16 +140,129 @@ int attach(char *iface, unsigned int xdp_flags)
     return 0;
 }
 
-// Load and attach the eBPF program. If the program is already loaded
-// it reloads it but through a different id (different file descriptor)
+// Attach the XDP program on the interface in front of the program
+// already attached (if any): carnx counts the packets and then hands
+// them to this program through a tail call, so it gives the verdict.
+// The xdp_flags must match the mode of the program in place
+int attach_chained(char *iface, unsigned int xdp_flags)
+{
+    if (CONTEXT.obj == NULL)
+        return -1;
+    if (CONTEXT.is_attached == true)
+    {
+        warnf("user", "The program is already attached");
+        return 0;
+    }
+
+    int next_fd = get_attached_program_fd(iface, xdp_flags);
+    if (next_fd < 0)
+        return -2;
+    if (next_fd == 0)
+    {
+        infof("user", "No program to chain on %s", iface);
+        return attach(iface, xdp_flags);
+    }
+    // a carnx program left by a previous run is replaced, not chained
+    // (it would count the packets again into a map nobody reads)
+    if (is_carnx_program(next_fd))
+    {
+        warnf("user", "A carnx program is already attached to %s, it is not chained", iface);
+        close(next_fd);
+        return attach(iface, xdp_flags);
+    }
+
+    // the slot must be filled before carnx receives packets
+    if (set_chain_program(CONTEXT.obj, next_fd) < 0)
+    {
+        close(next_fd);
+        return -3;
+    }
+    if (replace_bpf_program(CONTEXT.prog_fd, next_fd, iface, xdp_flags) < 0)
+    {
+        set_chain_program(CONTEXT.obj, -1);
+        close(next_fd);
+        return -4;
+    }
+
+    // update context
+    CONTEXT.xdp_flags = xdp_flags;
+    strncpy(CONTEXT.iface, iface, IFACE_LENGTH);
+    CONTEXT.is_attached = true;
+    CONTEXT.is_chained = true;
+    CONTEXT.chained_fd = next_fd;
+    infof("user", "BPF program chained in front of the program of %s", iface);
+    return 0;
+}
+
+// Measure the cost of the chaining hop on a test instance of the
+// program (BPF_PROG_TEST_RUN). It gives the average duration (ns) of
+// the pipeline alone and when it hands the packets to a no-op program
+int measure_chain_hop(char *filename, unsigned int features, int repeat, u32 *alone, u32 *chained)
+{
+    struct bpf_object *obj;
+    struct bpf_program *pass;
+    int prog_fd = -1;
+    int r = 0;
+
+    // fresh maps: the live counters are not touched
+    obj = load_specialized_bpf_program(filename, normalize_features(features), NULL, true, &prog_fd);
+    if (obj == NULL)
+    {
+        errorf("user", "Error while loading BPF program %s", filename);
+        return -1;
+    }
+    pass = find_program_by_section(obj, XDP_CARNX_PASS_SECTION);
+    if (!pass)
+    {
+        errorf("user", "No no-op program in %s", filename);
+        bpf_object__close(obj);
+        return -2;
+    }
+
+    if (measure_bpf_program(prog_fd, repeat, alone) < 0 ||
+        set_chain_program(obj, bpf_program__fd(pass)) < 0 ||
+        measure_bpf_program(prog_fd, repeat, chained) < 0)
+        r = -3;
+
+    bpf_object__close(obj);
+    return r;
+}
+
+// Load and attach the eBPF program with the given counter groups
+// (see enum Feature). If a program is already loaded, it is upgraded
+// in place (see upgrade) and moved to the interface if needed
 // It returns a negative integer when an error occured
 // -1: Error while loading BPF program
 // -2: Error while retrieving the file descriptor of the map
 // -3: Error while attaching program
-int load_and_attach(char *filename, char *iface, unsigned int xdp_flags)
+// -4: Another XDP program is attached to the interface
+int load_and_attach(char *filename, char *iface, unsigned int xdp_flags, unsigned int features)
 {
+    // do not reload a second object on top of the running one
+    if (CONTEXT.is_loaded)
+    {
+        int r = upgrade(filename, features);
+        if (r < 0)
+            return r == -3 ? -3 : -1;
+        if (CONTEXT.is_attached &&
+            CONTEXT.xdp_flags == xdp_flags &&
+            strncmp(CONTEXT.iface, iface, IFACE_LENGTH) == 0)
+            return 0;
+        // attached elsewhere (or with other flags)
+        if (CONTEXT.is_attached && detach() < 0)
+            return -3;
+        r = attach(iface, xdp_flags);
+        if (r < 0)
+        {
+            errorf("user", "Error while attaching program to %s", iface);
+            return r == -2 ? -4 : -3;
+        }
+        return 0;
+    }
+
+    features = normalize_features(features);
     // init the object, load and attach everything
-    CONTEXT.obj = load_bpf_program(filename, &CONTEXT.prog_fd);
+    CONTEXT.obj = load_specialized_bpf_program(filename, features, NULL, true, &CONTEXT.prog_fd);
     if (CONTEXT.obj == NULL)
     {
         errorf("user", "Error while loading BPF program %s", filename);
@@ -97,6 +270,7 @@ int load_and_attach(char *filename, char *iface, unsigned int xdp_flags)
     }
     // set flag
     CONTEXT.is_loaded = true;
+    CONTEXT.features = features;
 
     // Get back the map
     CONTEXT.map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_MAP_NAME);
@@ -107,10 +281,11 @@ int load_and_attach(char *filename, char *iface, unsigned int xdp_flags)
     }
 
     // attach
-    if (attach_bpf_program(CONTEXT.prog_fd, iface, CONTEXT.xdp_flags) < 0)
+    int r = attach_bpf_program(CONTEXT.prog_fd, iface, xdp_flags);
+    if (r < 0)
     {
         errorf("user", "Error while attaching program to %s", iface);
-        return -3;
+        return r == -EBUSY ? -4 : -3;
     }
 
     // update context
@@ -120,39 +295,318 @@ int load_and_attach(char *filename, char *iface, unsigned int xdp_flags)
     return 0;
 }
 
-// Get the counter value related to the given key
-u64 get_counter(int key)
+// Put the stages plugged at runtime into the pipeline of obj. The
+// other slots get the built-in stages of obj
+static int restore_pipeline(struct bpf_object *obj, unsigned int features)
+{
+    int stage;
+    int err = 0;
+    for (stage = 0; stage < __END_OF_STAGES__; stage++)
+    {
+        if (CONTEXT.stages[stage] != NULL)
+            err |= set_stage_program(obj, stage, CONTEXT.stage_fds[stage]);
+        else
+            err |= reset_stage_program(obj, stage, features);
+    }
+    return err;
+}
+
+// Replace the running eBPF program by a new one, built with the given
+// counter groups. The new program reuses the current counter map
+// (counters are not reset) and, when the program is attached, it is
+// swapped atomically on the interface. The old program is then released.
+// It returns a negative integer when an error occured
+// -1: Error while loading BPF program
+// -2: Error while retrieving the file descriptor of the map
+// -3: Error while replacing program
+// -4: No program is loaded
+int upgrade(char *filename, unsigned int features)
+{
+    struct bpf_object *obj;
+    int prog_fd = -1;
+    int map_fd;
+
+    if (CONTEXT.is_loaded == false)
+    {
+        errorf("user", "No program to upgrade");
+        return -4;
+    }
+
+    features = normalize_features(features);
+    // the pipeline is shared: it is left untouched until the
+    // new entrypoint is in place (the old one keeps its stages)
+    obj = load_specialized_bpf_program(filename, features, CONTEXT.obj, false, &prog_fd);
+    if (obj == NULL)
+    {
+        errorf("user", "Error while loading BPF program %s", filename);
+        return -1;
+    }
+
+    map_fd = get_map_fd_from_name(obj, XDP_CARNX_MAP_NAME);
+    if (map_fd < 0)
+    {
+        errorf("user", "Error while retrieving the file descriptor of map %s", XDP_CARNX_MAP_NAME);
+        bpf_object__close(obj);
+        return -2;
+    }
+
+    // swap (the old program stays attached if it fails)
+    if (CONTEXT.is_attached &&
+        replace_bpf_program(prog_fd, CONTEXT.prog_fd, CONTEXT.iface, CONTEXT.xdp_flags) < 0)
+    {
+        errorf("user", "Error while replacing program on %s", CONTEXT.iface);
+        bpf_object__close(obj);
+        return -3;
+    }
+
+    // then the new stages, except the ones plugged at runtime
+    restore_pipeline(obj, features);
+
+    // swap the egress program too (the old one keeps counting on failure)
+    if (CONTEXT.is_egress_attached)
+    {
+        int tc_fd = get_tc_program_fd(obj);
+        if (tc_fd < 0 || attach_tc_program(tc_fd, CONTEXT.iface) < 0)
+            warnf("user", "The egress program has not been upgraded");
+    }
+
+    // release the old program (the map survives through the new object)
+    bpf_object__close(CONTEXT.obj);
+
+    // update context
+    CONTEXT.obj = obj;
+    CONTEXT.prog_fd = prog_fd;
+    CONTEXT.map_fd = map_fd;
+    CONTEXT.features = features;
+    infof("user", "BPF program upgraded to %s", filename);
+    return 0;
+}
+
+// Load a single stage of the parser pipeline (enum Stage) from
+// filename and put it in place of the current one. The program
+// remains attached (the stage is swapped atomically)
+// It returns a negative integer when an error occured
+// -1: Error while loading the stage
+// -2: Error while setting the stage
+// -4: No program is loaded
+int plug_stage(int stage, char *filename)
+{
+    struct bpf_object *obj;
+    struct bpf_object *previous;
+    int prog_fd = -1;
+
+    if (CONTEXT.is_loaded == false)
+    {
+        errorf("user", "The program must be loaded first");
+        return -4;
+    }
+    if (stage < 0 || stage >= __END_OF_STAGES__)
+    {
+        errorf("user", "Unknown stage %d", stage);
+        return -2;
+    }
+
+    // the stage shares the maps of the loaded program (its
+    // own stages are not registered: only this slot changes)
+    obj = load_specialized_bpf_program(filename, CONTEXT.features, CONTEXT.obj, false, &prog_fd);
+    if (obj == NULL)
+    {
+        errorf("user", "Error while loading stage %s", filename);
+        return -1;
+    }
+    prog_fd = get_stage_program_fd(obj, stage);
+
+    // through the pipeline of the loaded program (the
+    // stage object may not declare it)
+    if (prog_fd < 0 || set_stage_program(CONTEXT.obj, stage, prog_fd))
+    {
+        bpf_object__close(obj);
+        return -2;
+    }
+    previous = CONTEXT.stages[stage];
+    CONTEXT.stages[stage] = obj;
+    CONTEXT.stage_fds[stage] = prog_fd;
+
+    // release the previous plugged stage
+    if (previous != NULL)
+        bpf_object__close(previous);
+    infof("user", "Stage %d plugged from %s", stage, filename);
+    return 0;
+}
+
+// Remove a stage plugged at runtime. The built-in stage
+// is restored (if the loaded program provides one)
+int unplug_stage(int stage)
+{
+    if (stage < 0 || stage >= __END_OF_STAGES__)
+    {
+        errorf("user", "Unknown stage %d", stage);
+        return -2;
+    }
+    if (CONTEXT.stages[stage] == NULL)
+    {
+        warnf("user", "No stage plugged at slot %d", stage);
+        return 0;
+    }
+    if (reset_stage_program(CONTEXT.obj, stage, CONTEXT.features) < 0)
+        return -2;
+
+    bpf_object__close(CONTEXT.stages[stage]);
+    CONTEXT.stages[stage] = NULL;
+    CONTEXT.stage_fds[stage] = 0;
+    infof("user", "Stage %d unplugged", stage);
+    return 0;
+}
+
+// Sum the per-CPU blocks of a direction of the counter map (enum
+// Direction) into sums (COUNTER_STRIDE values). All the counters of the
+// direction are read with a single lookup
+static int read_counters(int dir, u64 *sums)
 {
     /* For percpu maps, userspace gets a value per possible CPU */
     unsigned int nr_cpus = libbpf_num_possible_cpus();
-    u64 values[nr_cpus];
-    u64 accumulator = 0;
-    int i = 0;
+    struct counters *blocks;
+    u32 key = dir;
+    int i, c;
 
-    if (bpf_map_lookup_elem(CONTEXT.map_fd, &key, values) != 0)
+    memset(sums, 0, COUNTER_STRIDE * sizeof(u64));
+    blocks = malloc(nr_cpus * sizeof(struct counters));
+    if (blocks == NULL)
+        return -1;
+    if (bpf_map_lookup_elem(CONTEXT.map_fd, &key, blocks) != 0)
     {
+        __atomic_fetch_add(&map_read_errors, 1, __ATOMIC_RELAXED);
         errorf("user", "BPF map lookup failed, failed key:0x%X ", key);
-        return 0;
+        free(blocks);
+        return -1;
     }
 
     /* Sum values from each CPU */
     for (i = 0; i < nr_cpus; i++)
     {
-        accumulator += values[i];
+        for (c = 0; c < COUNTER_STRIDE; c++)
+            sums[c] += blocks[i].values[c];
     }
-    return accumulator;
+    free(blocks);
+    return 0;
+}
+
+// Read a single counter of a direction
+static u64 read_counter(int dir, int key)
+{
+    u64 sums[COUNTER_STRIDE];
+    if (key < 0 || key >= __END_OF_COUNTERS__)
+    {
+        errorf("user", "Unknown counter %d", key);
+        return 0;
+    }
+    if (read_counters(dir, sums) < 0)
+        return 0;
+    return sums[key];
+}
+
+// Return the number of failed lookups of the counter map
+u64 get_map_read_errors()
+{
+    return __atomic_load_n(&map_read_errors, __ATOMIC_RELAXED);
+}
+
+// Get all the counter values of a direction (a single lookup). The
+// counters which are not compiled in are set to 0
+static int get_direction_counters(int dir, u64 *array)
+{
+    u64 sums[COUNTER_STRIDE];
+    int i;
+    int r = read_counters(dir, sums);
+    for (i = 0; i < nb_counters(); i++)
+    {
+        if (r == 0 && is_counter_active(i))
+            array[i] = sums[i];
+        else
+            array[i] = 0;
+    }
+    return r;
+}
+
+// Get the counter value related to the given key
+u64 get_counter(int key)
+{
+    return read_counter(DIR_RX, key);
+}
+
+// Get the egress counter value related to the given key
+u64 get_tx_counter(int key)
+{
+    return read_counter(DIR_TX, key);
 }
 
 // Get all counter values. You must ensure that the
-// returned buffer has length >= nb_counters()
+// returned buffer has length >= nb_counters(). The
+// counters which are not compiled in are set to 0
 int get_all_counters(u64 *array)
 {
+    return get_direction_counters(DIR_RX, array);
+}
+
+// Check whether the counter is updated by the
+// loaded program (its group is enabled)
+bool is_counter_active(int key)
+{
+    unsigned int feature = counter_feature(key);
+    return feature != 0 && (CONTEXT.features & feature) == feature;
+}
+
+// Get the k most seen (hashed) server names of the SNI table. You
+// must ensure that hashes and counts have length >= k. It returns
+// the number of entries filled (sorted by decreasing count)
+int get_sni_top(u32 *hashes, u64 *counts, int k)
+{
+    unsigned int nr_cpus = libbpf_num_possible_cpus();
+    u64 values[nr_cpus];
+    u64 accumulator;
+    u32 key, next_key;
+    void *prev = NULL;
+    int n = 0;
     int i;
-    for (i = 0; i < nb_counters(); i++)
+
+    if (CONTEXT.is_loaded == false)
     {
-        array[i] = get_counter(i);
+        errorf("user", "The program is not loaded");
+        return -1;
     }
-    return 0;
+    int map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_SNI_NAME);
+    if (map_fd < 0)
+        return -1;
+
+    while (bpf_map_get_next_key(map_fd, prev, &next_key) == 0)
+    {
+        key = next_key;
+        prev = &key;
+        if (bpf_map_lookup_elem(map_fd, &key, values) != 0)
+            continue;
+
+        accumulator = 0;
+        for (i = 0; i < nr_cpus; i++)
+            accumulator += values[i];
+
+        // insertion into the (sorted) top-k
+        for (i = n; i > 0 && counts[i - 1] < accumulator; i--)
+        {
+            if (i < k)
+            {
+                hashes[i] = hashes[i - 1];
+                counts[i] = counts[i - 1];
+            }
+        }
+        if (i < k)
+        {
+            hashes[i] = key;
+            counts[i] = accumulator;
+            if (n < k)
+                n++;
+        }
+    }
+    return n;
 }
 
 // Get all counter values. You must ensure that the
@@ -177,7 +631,311 @@ int get_all_counters_with_timestamp(u64 *array, u64 *sec, u64 *nsec)
     return get_all_counters(array);
 }
 
+// Get the packet and bit rates of a direction (enum Direction),
+// merged over the CPUs. The estimate of a CPU which has not seen
+// any packet since its last bucket is decayed as if its next
+// buckets were empty
+int get_rates(int dir, u64 *pps, u64 *bps)
+{
+    unsigned int nr_cpus = libbpf_num_possible_cpus();
+    struct rate values[nr_cpus];
+    struct timespec ts;
+    u32 key = dir;
+    u64 now, elapsed;
+    s64 cpu_pps, cpu_bps;
+    int i;
+
+    if (CONTEXT.is_loaded == false)
+    {
+        errorf("user", "The program is not loaded");
+        return -1;
+    }
+    if (!(CONTEXT.features & FEATURE_RATES))
+    {
+        errorf("user", "The rate estimators are not enabled");
+        return -3;
+    }
+    int map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_RATES_NAME);
+    if (map_fd < 0)
+        return -2;
+    if (bpf_map_lookup_elem(map_fd, &key, values) != 0)
+    {
+        errorf("user", "BPF map lookup failed (%s)", strerror(errno));
+        return -2;
+    }
+
+    // same clock as bpf_ktime_get_ns
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    now = ts.tv_sec * 1000000000UL + ts.tv_nsec;
+
+    *pps = 0;
+    *bps = 0;
+    for (i = 0; i < nr_cpus; i++)
+    {
+        if (values[i].bucket_start == 0 || values[i].bucket_start > now)
+            continue;
+        cpu_pps = values[i].pps;
+        cpu_bps = values[i].bps;
+
+        elapsed = now - values[i].bucket_start;
+        if (elapsed > (RATE_BUCKET_NS << 6))
+            continue;
+        // as if a packet arrived now (see update_rate)
+        if (elapsed >= RATE_BUCKET_NS)
+            close_rate_buckets(&cpu_pps, &cpu_bps, values[i].packets, values[i].bytes, elapsed);
+        *pps += cpu_pps;
+        *bps += cpu_bps;
+    }
+    return 0;
+}
+
+// Get all counter values of both directions (ingress into rx,
+// egress into tx). You must ensure that the returned buffers have
+// length >= nb_counters(). It returns the timestamp of the action
+int get_rx_tx_counters_with_timestamp(u64 *rx, u64 *tx, u64 *sec, u64 *nsec)
+{
+    get_all_counters_with_timestamp(rx, sec, nsec);
+    if (CONTEXT.is_egress_attached)
+        return get_direction_counters(DIR_TX, tx);
+    memset(tx, 0, nb_counters() * sizeof(u64));
+    return 0;
+}
+
+// Ring buffer callback: move the record into the queue
+static int on_sample(void *ctx, void *data, size_t size)
+{
+    struct sample *s;
+
+    if (size < sizeof(struct sample))
+        return 0;
+
+    pthread_mutex_lock(&SAMPLER.lock);
+    if (SAMPLER.count == SAMPLE_QUEUE_SIZE)
+    {
+        SAMPLER.overflow++;
+        pthread_mutex_unlock(&SAMPLER.lock);
+        return 0;
+    }
+    s = &SAMPLER.queue[(SAMPLER.head + SAMPLER.count) % SAMPLE_QUEUE_SIZE];
+    memcpy(s, data, sizeof(struct sample));
+    s->timestamp += SAMPLER.clock_offset;
+    SAMPLER.count++;
+    pthread_cond_signal(&SAMPLER.ready);
+    pthread_mutex_unlock(&SAMPLER.lock);
+    return 0;
+}
+
+// Consumer thread: drain the ring buffer (all the
+// available records are processed at each wake up)
+static void *consume_samples(void *arg)
+{
+    int err;
+    while (__atomic_load_n(&SAMPLER.running, __ATOMIC_RELAXED))
+    {
+        err = ring_buffer__poll(SAMPLER.rb, 100);
+        if (err < 0 && err != -EINTR)
+        {
+            errorf("user", "Error while polling the samples (%d)", err);
+            break;
+        }
+    }
+    return NULL;
+}
+
+static int start_sampler()
+{
+    struct timespec real, mono;
+
+    if (__atomic_load_n(&SAMPLER.running, __ATOMIC_RELAXED))
+        return 0;
+
+    int map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_SAMPLES_NAME);
+    if (map_fd < 0)
+        return -1;
+    SAMPLER.map_fd = dup(map_fd);
+    if (SAMPLER.map_fd < 0)
+    {
+        errorf("user", "Error while duplicating the samples map fd (%s)", strerror(errno));
+        return -1;
+    }
+    SAMPLER.rb = ring_buffer__new(SAMPLER.map_fd, on_sample, NULL, NULL);
+    if (SAMPLER.rb == NULL)
+    {
+        errorf("user", "Error while creating the samples consumer");
+        close(SAMPLER.map_fd);
+        SAMPLER.map_fd = -1;
+        return -1;
+    }
+
+    clock_gettime(CLOCK_REALTIME, &real);
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    SAMPLER.clock_offset = (real.tv_sec - mono.tv_sec) * 1000000000UL + real.tv_nsec - mono.tv_nsec;
+
+    __atomic_store_n(&SAMPLER.running, true, __ATOMIC_RELAXED);
+    if (pthread_create(&SAMPLER.thread, NULL, consume_samples, NULL) != 0)
+    {
+        errorf("user", "Error while starting the samples consumer");
+        __atomic_store_n(&SAMPLER.running, false, __ATOMIC_RELAXED);
+        ring_buffer__free(SAMPLER.rb);
+        SAMPLER.rb = NULL;
+        close(SAMPLER.map_fd);
+        SAMPLER.map_fd = -1;
+        return -1;
+    }
+    debugf("user", "Samples consumer started");
+    return 0;
+}
+
+static void stop_sampler()
+{
+    if (!__atomic_load_n(&SAMPLER.running, __ATOMIC_RELAXED))
+        return;
+
+    __atomic_store_n(&SAMPLER.running, false, __ATOMIC_RELAXED);
+    pthread_join(SAMPLER.thread, NULL);
+    ring_buffer__free(SAMPLER.rb);
+    SAMPLER.rb = NULL;
+    close(SAMPLER.map_fd);
+    SAMPLER.map_fd = -1;
+
+    // wake up the readers
+    pthread_mutex_lock(&SAMPLER.lock);
+    SAMPLER.head = 0;
+    SAMPLER.count = 0;
+    pthread_cond_broadcast(&SAMPLER.ready);
+    pthread_mutex_unlock(&SAMPLER.lock);
+    debugf("user", "Samples consumer stopped");
+}
+
+// Export 1 packet out of rate (0 turns the sampling off). The
+// consumer thread is started on the first call, it drains the
+// ring buffer until the program is unloaded
+int set_sample_rate(u32 rate)
+{
+    u32 key = SAMPLER_RATE;
+    u64 value = rate;
+
+    if (CONTEXT.is_loaded == false)
+    {
+        errorf("user", "The program is not loaded");
+        return -1;
+    }
+    int map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_SAMPLER_NAME);
+    if (map_fd < 0)
+        return -2;
+    if (bpf_map_update_elem(map_fd, &key, &value, BPF_ANY) != 0)
+    {
+        errorf("user", "Error while setting the sample rate (%s)", strerror(errno));
+        return -2;
+    }
+    if (rate > 0 && start_sampler() < 0)
+        return -3;
+    return 0;
+}
+
+// Read at most max samples, waiting up to timeout_ms for the first
+// one. You must ensure that buf has length >= max. It returns the
+// number of samples read (0 on timeout)
+int read_samples(struct sample *buf, int max, int timeout_ms)
+{
+    struct timespec deadline;
+    int n = 0;
+
+    // (stop_sampler may run in another thread)
+    if (!__atomic_load_n(&SAMPLER.running, __ATOMIC_RELAXED))
+        return -1;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&SAMPLER.lock);
+    while (SAMPLER.count == 0 && __atomic_load_n(&SAMPLER.running, __ATOMIC_RELAXED))
+    {
+        if (pthread_cond_timedwait(&SAMPLER.ready, &SAMPLER.lock, &deadline) != 0)
+            break;
+    }
+    while (n < max && SAMPLER.count > 0)
+    {
+        buf[n++] = SAMPLER.queue[SAMPLER.head];
+        SAMPLER.head = (SAMPLER.head + 1) % SAMPLE_QUEUE_SIZE;
+        SAMPLER.count--;
+    }
+    pthread_mutex_unlock(&SAMPLER.lock);
+    return n;
+}
+
+// Return the number of samples lost so far (ring buffer
+// or consumer queue full)
+u64 get_dropped_samples()
+{
+    u32 key = SAMPLER_DROPPED;
+    u64 dropped = 0;
+
+    if (CONTEXT.is_loaded)
+    {
+        int map_fd = get_map_fd_from_name(CONTEXT.obj, XDP_CARNX_SAMPLER_NAME);
+        if (map_fd >= 0)
+            bpf_map_lookup_elem(map_fd, &key, &dropped);
+    }
+    pthread_mutex_lock(&SAMPLER.lock);
+    dropped += SAMPLER.overflow;
+    pthread_mutex_unlock(&SAMPLER.lock);
+    return dropped;
+}
+
+// Count the outgoing packets of the interface where the XDP program
+// is attached (TC egress hook). The same counters are updated
+int attach_egress()
+{
+    if (CONTEXT.is_attached == false)
+    {
+        errorf("user", "The program must be attached first");
+        return -1;
+    }
+    if (CONTEXT.is_egress_attached)
+    {
+        warnf("user", "The egress program is already attached");
+        return 0;
+    }
+    int prog_fd = get_tc_program_fd(CONTEXT.obj);
+    if (prog_fd < 0)
+    {
+        errorf("user", "The loaded object has no egress program");
+        return -2;
+    }
+    if (attach_tc_program(prog_fd, CONTEXT.iface) < 0)
+        return -3;
+
+    // update context
+    CONTEXT.is_egress_attached = true;
+    return 0;
+}
+
+// Stop counting the outgoing packets
+int detach_egress()
+{
+    if (CONTEXT.is_egress_attached == false)
+    {
+        warnf("user", "The egress program is not attached");
+        return 0;
+    }
+    int r = detach_tc_program(CONTEXT.iface);
+    if (r < 0)
+        return r;
+
+    // update context
+    CONTEXT.is_egress_attached = false;
+    return 0;
+}
+
 // Detach the XDP program from the interface
+// (and the egress program if any)
 int detach()
 {
     if (CONTEXT.obj == NULL)
@@ -190,9 +948,27 @@ int detach()
         warnf("user", "The program is not attached");
         return 0;
     }
-    int r = detach_bpf_program(CONTEXT.iface, CONTEXT.xdp_flags);
-    if (r < 0)
-        return r;
+    if (CONTEXT.is_egress_attached && detach_egress() < 0)
+        return -1;
+
+    int r;
+    if (CONTEXT.is_chained)
+    {
+        // put the previous program back (atomically)
+        r = replace_bpf_program(CONTEXT.chained_fd, CONTEXT.prog_fd, CONTEXT.iface, CONTEXT.xdp_flags);
+        if (r < 0)
+            return r;
+        set_chain_program(CONTEXT.obj, -1);
+        close(CONTEXT.chained_fd);
+        CONTEXT.chained_fd = -1;
+        CONTEXT.is_chained = false;
+    }
+    else
+    {
+        r = detach_own_bpf_program(CONTEXT.prog_fd, CONTEXT.iface, CONTEXT.xdp_flags);
+        if (r < 0)
+            return r;
+    }
 
     // update context
     CONTEXT.is_attached = false;
@@ -212,6 +988,16 @@ int unload()
         errorf("user", "The program must be detached first");
         return -1;
     }
+    // the samples map is released with the program
+    stop_sampler();
+    // release the stages plugged at runtime
+    for (int stage = 0; stage < __END_OF_STAGES__; stage++)
+    {
+        if (CONTEXT.stages[stage] == NULL)
+            continue;
+        bpf_object__close(CONTEXT.stages[stage]);
+        CONTEXT.stages[stage] = NULL;
+    }
     int r = unload_bpf_program(CONTEXT.obj);
     // set flag
     if (r == 0)
@@ -231,6 +1017,18 @@ bool is_attached()
     return CONTEXT.is_attached;
 }
 
+// return the attach status of the egress program
+bool is_egress_attached()
+{
+    return CONTEXT.is_egress_attached;
+}
+
+// return whether carnx runs in front of another program
+bool is_chained()
+{
+    return CONTEXT.is_chained;
+}
+
 // Return the interface where the program
 // is attached. You must ensure that dest
 // points to a buffer with IFACE_LENGTH size.
@@ -1,6 +1,7 @@
 #include "common.h"
 #include "loader.h"
 // system imports
+#include <pthread.h>
 
 // local
 #include "libbpf/src/libbpf.h"
@@ -10,6 +11,7 @@
 #define _USER_H_
 
 #define IFACE_LENGTH 32
+#define SAMPLE_QUEUE_SIZE 4096 // samples buffered between the consumer thread and the readers
 
 struct context
 {
@@ -19,8 +21,16 @@ struct context
     struct bpf_map *map;
     char iface[IFACE_LENGTH];
     unsigned int xdp_flags;
+    unsigned int features;
     bool is_loaded;
     bool is_attached;
+    bool is_egress_attached;
+    // program attached before carnx (chaining mode)
+    bool is_chained;
+    int chained_fd;
+    // stages plugged at runtime (NULL: built-in stage)
+    struct bpf_object *stages[__END_OF_STAGES__];
+    int stage_fds[__END_OF_STAGES__];
 };
 
 // debug
@@ -29,26 +39,106 @@ void debug_context();
 // Get the counter value related to the given key
 u64 get_counter(int key);
 
+// Return the number of failed lookups of the counter map
+u64 get_map_read_errors();
+
 // Get all counter values. You must ensure that the
-// returned buffer has length >= nb_counters()
+// returned buffer has length >= nb_counters(). The
+// counters which are not compiled in are set to 0
 int get_all_counters(u64 *array);
 
+// Get the egress counter value related to the given key
+u64 get_tx_counter(int key);
+
+// Get the packet and bit rates of a direction (enum Direction),
+// merged over the CPUs. The estimate of a CPU which has not seen
+// any packet since its last bucket is decayed as if its next
+// buckets were empty
+int get_rates(int dir, u64 *pps, u64 *bps);
+
+// Get all counter values of both directions (ingress into rx,
+// egress into tx). You must ensure that the returned buffers have
+// length >= nb_counters(). It returns the timestamp of the action
+int get_rx_tx_counters_with_timestamp(u64 *rx, u64 *tx, u64 *sec, u64 *nsec);
+
+// Check whether the counter is updated by the
+// loaded program (its group is enabled)
+bool is_counter_active(int key);
+
+// Get the k most seen (hashed) server names of the SNI table. You
+// must ensure that hashes and counts have length >= k. It returns
+// the number of entries filled (sorted by decreasing count)
+int get_sni_top(u32 *hashes, u64 *counts, int k);
+
 // Get all counter values. You must ensure that the
 // returned buffer has length >= nb_counters(). It returns
 // the timestamp of the action (seconds and nanoseconds)
 int get_all_counters_with_timestamp(u64 *array, u64 *sec, u64 *nsec);
 
-// Load an eBPF program into the kernel
-int load(char *filename);
+// Export 1 packet out of rate (0 turns the sampling off). The
+// consumer thread is started on the first call, it drains the
+// ring buffer until the program is unloaded
+int set_sample_rate(u32 rate);
 
-// Attach the XDP program on the interface
-int attach(char *iface, unsigned int xdp_flags);
+// Read at most max samples, waiting up to timeout_ms for the first
+// one. You must ensure that buf has length >= max. It returns the
+// number of samples read (0 on timeout)
+int read_samples(struct sample *buf, int max, int timeout_ms);
+
+// Return the number of samples lost so far (ring buffer
+// or consumer queue full)
+u64 get_dropped_samples();
+
+// Load an eBPF program into the kernel with the given counter groups
+// (see enum Feature, 0 means the default ones). If a program is
+// already loaded, it is upgraded in place (see upgrade)
+int load(char *filename, unsigned int features);
 
-// Load and attach the eBPF program. If the program is already loaded
-// it reloads it but through a different id (different file descriptor)
-int load_and_attach(char *filename, char *iface, unsigned int xdp_flags);
+// Attach the XDP program on the interface. It does not replace
+// a program already attached (see attach_chained)
+int attach(char *iface, unsigned int xdp_flags);
 
-// Detach the XDP program from the interface
+// Attach the XDP program on the interface in front of the program
+// already attached (if any): carnx counts the packets and then hands
+// them to this program through a tail call, so it gives the verdict.
+// The xdp_flags must match the mode of the program in place
+int attach_chained(char *iface, unsigned int xdp_flags);
+
+// Measure the cost of the chaining hop on a test instance of the
+// program (BPF_PROG_TEST_RUN). It gives the average duration (ns) of
+// the pipeline alone and when it hands the packets to a no-op program
+int measure_chain_hop(char *filename, unsigned int features, int repeat, u32 *alone, u32 *chained);
+
+// Load and attach the eBPF program with the given counter groups
+// (see enum Feature, 0 means the default ones). If a program is already loaded,
+// it is upgraded in place (see upgrade) and moved to the interface if needed
+int load_and_attach(char *filename, char *iface, unsigned int xdp_flags, unsigned int features);
+
+// Replace the running eBPF program by a new one, built with the given
+// counter groups (0 means the default ones). The new program reuses the current
+// counter map (counters are not reset) and, when the program is attached,
+// it is swapped atomically on the interface. The old program is then released
+int upgrade(char *filename, unsigned int features);
+
+// Load a single stage of the parser pipeline (enum Stage) from
+// filename and put it in place of the current one. The program
+// remains attached (the stage is swapped atomically)
+int plug_stage(int stage, char *filename);
+
+// Remove a stage plugged at runtime. The built-in stage
+// is restored (if the loaded program provides one)
+int unplug_stage(int stage);
+
+// Count the outgoing packets of the interface where the XDP program
+// is attached (TC egress hook). The same counters are updated
+int attach_egress();
+
+// Stop counting the outgoing packets
+int detach_egress();
+
+// Detach the XDP program from the interface (and the egress program
+// if any). Only carnx is removed: in chaining mode, the program which
+// was attached before is put back
 int detach();
 
 // Unload the eBPF program from the kernel
@@ -60,6 +150,12 @@ bool is_loaded();
 // return the attach status
 bool is_attached();
 
+// return the attach status of the egress program
+bool is_egress_attached();
+
+// return whether carnx runs in front of another program
+bool is_chained();
+
 // Return the interface where the program
 // is attached. You must ensure that dest
 // points to a buffer with IFACE_LENGTH size.
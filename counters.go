@@ -0,0 +1,60 @@
+// Code generated by c/schema.sh from c/counters.def. DO NOT EDIT.
+
+package main
+
+// schemaHash identifies the counter schema (see C.schema_hash)
+const schemaHash = 2122495461
+
+// counterNames gives the name of the counters (index: enum Counter)
+var counterNames = []string{
+	"PKT",
+	"IP",
+	"IP6",
+	"TCP",
+	"UDP",
+	"ICMP",
+	"ICMP6",
+	"ARP",
+	"ACK",
+	"SYN",
+	"DNS_QUERY",
+	"DNS_RESPONSE",
+	"DNS_A",
+	"DNS_AAAA",
+	"DNS_ANY",
+	"DNS_OTHER",
+	"HTTP_GET",
+	"HTTP_POST",
+	"HTTP_OTHER",
+	"TLS_HELLO",
+	"TLS10",
+	"TLS11",
+	"TLS12",
+}
+
+// lookUp returns the key given the name of the counter
+var lookUp = map[string]int{
+	"PKT":          0,
+	"IP":           1,
+	"IP6":          2,
+	"TCP":          3,
+	"UDP":          4,
+	"ICMP":         5,
+	"ICMP6":        6,
+	"ARP":          7,
+	"ACK":          8,
+	"SYN":          9,
+	"DNS_QUERY":    10,
+	"DNS_RESPONSE": 11,
+	"DNS_A":        12,
+	"DNS_AAAA":     13,
+	"DNS_ANY":      14,
+	"DNS_OTHER":    15,
+	"HTTP_GET":     16,
+	"HTTP_POST":    17,
+	"HTTP_OTHER":   18,
+	"TLS_HELLO":    19,
+	"TLS10":        20,
+	"TLS11":        21,
+	"TLS12":        22,
+}
@@ -0,0 +1,269 @@
+// federation.go
+//
+
+package main
+
+// #include "user.h"
+import "C"
+
+import (
+	"carnx/api"
+	"context"
+	"fmt"
+	"net"
+	"path/filepath"
+	"strings"
+	"sync"
+	"sync/atomic"
+	"time"
+
+	"google.golang.org/grpc"
+)
+
+const (
+	// upstreamPeriod is the period of the snapshots
+	// streamed by the upstream daemons (ms)
+	upstreamPeriod = 1000
+	// staleAfter is the delay without snapshot after which
+	// an upstream is considered down (it may hang)
+	staleAfter = 3 * upstreamPeriod * time.Millisecond
+	// minBackoff and maxBackoff bound the delay before
+	// reconnecting to a failed upstream
+	minBackoff = 1 * time.Second
+	maxBackoff = 30 * time.Second
+)
+
+// sourceState is the last known state of an upstream. It is never
+// modified once published, so it can be read without lock
+type sourceState struct {
+	up   bool
+	err  string
+	data map[string]uint64
+}
+
+// upstream is a carnxd endpoint whose counters are merged
+type upstream struct {
+	label string
+	path  string
+	state atomic.Value // *sourceState
+}
+
+// aggregator merges the snapshots of several carnxd endpoints.
+// Each upstream has its own persistent stream (and goroutine),
+// so a failed or slow upstream never blocks the merge
+type aggregator struct {
+	upstreams []*upstream
+	cancel    context.CancelFunc
+	wg        sync.WaitGroup
+}
+
+var (
+	// federation is the aggregator (nil when carnxd
+	// does not run in aggregator mode)
+	federation *aggregator
+)
+
+// parseUpstream reads an upstream given as label=path or
+// path (the label is then the name of the socket)
+func parseUpstream(arg string) *upstream {
+	u := &upstream{label: arg, path: arg}
+	if i := strings.Index(arg, "="); i > 0 {
+		u.label = arg[:i]
+		u.path = arg[i+1:]
+	} else {
+		u.label = strings.TrimSuffix(filepath.Base(arg), filepath.Ext(arg))
+	}
+	u.state.Store(&sourceState{err: "not connected yet"})
+	return u
+}
+
+// startFederation connects to the given upstreams and
+// keeps their latest snapshots
+func startFederation(args []string) error {
+	ctx, cancel := context.WithCancel(context.Background())
+	agg := &aggregator{cancel: cancel}
+	labels := make(map[string]bool)
+	for _, arg := range args {
+		u := parseUpstream(arg)
+		if labels[u.label] {
+			cancel()
+			return fmt.Errorf("Duplicated upstream label %s", u.label)
+		}
+		labels[u.label] = true
+		agg.upstreams = append(agg.upstreams, u)
+	}
+
+	for _, u := range agg.upstreams {
+		agg.wg.Add(1)
+		go func(u *upstream) {
+			defer agg.wg.Done()
+			u.follow(ctx)
+		}(u)
+	}
+	federation = agg
+	infof("Aggregating %d upstream(s)", len(agg.upstreams))
+	return nil
+}
+
+// stopFederation closes the upstream streams
+func stopFederation() {
+	if federation == nil {
+		return
+	}
+	federation.cancel()
+	federation.wg.Wait()
+}
+
+// dialUnix connects to a unix socket (the target is its path)
+func dialUnix(ctx context.Context, path string) (net.Conn, error) {
+	var d net.Dialer
+	return d.DialContext(ctx, "unix", path)
+}
+
+// follow keeps a snapshot stream open with the upstream until ctx is
+// done. The stream is re-opened (with backoff) when it fails or when
+// no snapshot arrives for staleAfter
+func (u *upstream) follow(ctx context.Context) {
+	conn, err := grpc.DialContext(ctx, u.path, grpc.WithInsecure(), grpc.WithContextDialer(dialUnix))
+	if err != nil {
+		u.down(err)
+		return
+	}
+	defer conn.Close()
+	client := api.NewCarnxClient(conn)
+
+	backoff := minBackoff
+	for {
+		// the watchdog cancels the stream of a silent upstream
+		streamCtx, cancelStream := context.WithCancel(ctx)
+		watchdog := time.AfterFunc(staleAfter, cancelStream)
+		stream, err := client.SnapshotStream(streamCtx, &api.StreamParameters{PeriodMs: upstreamPeriod})
+		for err == nil {
+			var snap *api.Snap
+			if snap, err = stream.Recv(); err == nil {
+				watchdog.Reset(staleAfter)
+				u.state.Store(&sourceState{up: true, data: snap.Data})
+				backoff = minBackoff
+			}
+		}
+		watchdog.Stop()
+		if streamCtx.Err() != nil && ctx.Err() == nil {
+			err = fmt.Errorf("No snapshot received for %v", staleAfter)
+		}
+		cancelStream()
+		u.down(err)
+
+		select {
+		case <-ctx.Done():
+			return
+		case <-time.After(backoff):
+		}
+		if backoff *= 2; backoff > maxBackoff {
+			backoff = maxBackoff
+		}
+	}
+}
+
+// down marks the upstream as failed (its last snapshot
+// is kept, and still merged as a stale one)
+func (u *upstream) down(err error) {
+	last := u.state.Load().(*sourceState)
+	u.state.Store(&sourceState{up: false, err: err.Error(), data: last.data})
+	debugf("Upstream %s is down: %v", u.label, err)
+}
+
+// merge builds the merged snapshot from the latest states of the
+// upstreams (it never waits for them). The last snapshot of a down
+// upstream is still summed, so the total does not drop when an
+// upstream fails (it may still drop when an upstream restarts)
+func (agg *aggregator) merge() *api.MergedSnap {
+	merged := &api.MergedSnap{
+		Time:    uint64(time.Now().UnixNano()),
+		Sources: make([]*api.SourceSnap, len(agg.upstreams)),
+		Total:   make(map[string]uint64),
+	}
+	for i, u := range agg.upstreams {
+		state := u.state.Load().(*sourceState)
+		merged.Sources[i] = &api.SourceSnap{
+			Source: u.label,
+			Up:     state.up,
+			Error:  state.err,
+			Data:   state.data,
+			Stale:  !state.up && state.data != nil,
+		}
+		for name, value := range state.data {
+			if name != "TIME" {
+				merged.Total[name] += value
+			}
+		}
+	}
+	return merged
+}
+
+// SnapshotStream sends a snapshot of the counters periodically
+func (a *CarnxServer) SnapshotStream(attr *api.StreamParameters, stream api.Carnx_SnapshotStreamServer) error {
+	ticker := time.NewTicker(streamPeriod(attr))
+	defer ticker.Stop()
+	for {
+		if !bool(C.is_loaded()) {
+			msg := "The program is not loaded"
+			errorf(msg)
+			return fmt.Errorf(msg)
+		}
+		snap, err := a.Snapshot(stream.Context(), &api.Garbage{})
+		if err != nil {
+			return err
+		}
+		if err := stream.Send(snap); err != nil {
+			return err
+		}
+
+		select {
+		case <-stream.Context().Done():
+			return nil
+		case <-stopping:
+			return nil
+		case <-ticker.C:
+		}
+	}
+}
+
+// MergedSnapshot returns the counters of all the upstreams
+// (aggregator mode). It does not wait for the upstreams
+func (a *CarnxServer) MergedSnapshot(ctx context.Context, garbage *api.Garbage) (*api.MergedSnap, error) {
+	if federation == nil {
+		return nil, fmt.Errorf("carnxd does not run in aggregator mode")
+	}
+	return federation.merge(), nil
+}
+
+// MergedSnapshotStream sends the merged snapshot periodically
+// (aggregator mode)
+func (a *CarnxServer) MergedSnapshotStream(attr *api.StreamParameters, stream api.Carnx_MergedSnapshotStreamServer) error {
+	if federation == nil {
+		return fmt.Errorf("carnxd does not run in aggregator mode")
+	}
+	ticker := time.NewTicker(streamPeriod(attr))
+	defer ticker.Stop()
+	for {
+		if err := stream.Send(federation.merge()); err != nil {
+			return err
+		}
+
+		select {
+		case <-stream.Context().Done():
+			return nil
+		case <-stopping:
+			return nil
+		case <-ticker.C:
+		}
+	}
+}
+
+// streamPeriod returns the period of a stream (default: 1s)
+func streamPeriod(attr *api.StreamParameters) time.Duration {
+	if attr.PeriodMs == 0 {
+		return time.Second
+	}
+	return time.Duration(attr.PeriodMs) * time.Millisecond
+}
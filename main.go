@@ -34,6 +34,30 @@ var app = &cli.App{
 			Aliases: []string{"x"},
 			Usage:   "XDP flags (set the way to attach the program to the interface)",
 		},
+		&cli.BoolFlag{
+			Name:    "chain",
+			Aliases: []string{"c"},
+			Usage:   "Run in front of the XDP program already attached to the interface",
+		},
+		&cli.BoolFlag{
+			Name:    "egress",
+			Aliases: []string{"e"},
+			Usage:   "Count the outgoing packets too (TC egress hook)",
+		},
+		&cli.UintFlag{
+			Name:    "features",
+			Value:   0,
+			Aliases: []string{"f"},
+			Usage:   "Counter groups to enable (1: PKT, 2: L2, 4: L3, 8: L4, 16: L7, 32: SNI, 64: rates, 0: default)",
+		},
+		&cli.BoolFlag{
+			Name:  "stats",
+			Usage: "Measure the RPCs and the calls to libcarnx (see the GetStats RPC)",
+		},
+		&cli.StringSliceFlag{
+			Name:  "upstream",
+			Usage: "Merge the counters of another carnxd (label=socket or socket, repeatable)",
+		},
 		&cli.StringFlag{
 			Name:    "unix",
 			Value:   "/run/carnx.sock",
@@ -54,10 +78,14 @@ func run(c *cli.Context) error {
 	if c.Bool("debug") {
 		setDebug()
 	}
+	if c.Bool("stats") {
+		setStats()
+	}
 
 	// loading
 	if prog := c.String("load"); prog != "" {
-		_, err := s.Load(nil, &api.LoadParameters{BpfProgram: prog})
+		_, err := s.Load(nil, &api.LoadParameters{BpfProgram: prog,
+			Features: uint32(c.Uint("features"))})
 		if err != nil {
 			return err
 		}
@@ -66,10 +94,25 @@ func run(c *cli.Context) error {
 		if iface := c.String("interface"); iface != "" {
 			_, err := s.Attach(nil,
 				&api.AttachParameters{Interface: iface,
-					XdpFlags: uint32(c.Uint("xdp-flags"))})
+					XdpFlags: uint32(c.Uint("xdp-flags")),
+					Chain:    c.Bool("chain")})
 			if err != nil {
 				return err
 			}
+
+			// counting the outgoing packets
+			if c.Bool("egress") {
+				if _, err := s.AttachEgress(nil, &api.Garbage{}); err != nil {
+					return err
+				}
+			}
+		}
+	}
+
+	// aggregator mode
+	if upstreams := c.StringSlice("upstream"); len(upstreams) > 0 {
+		if err := startFederation(upstreams); err != nil {
+			return err
 		}
 	}
 
@@ -9,19 +9,19 @@ package main
 // #include "user.h"
 //
 // void __server_debug(char * msg) {
-//     return debugf("server", msg);
+//     return debugf("server", "%s", msg);
 // }
 //
 // void __server_info(char * msg) {
-//     return infof("server", msg);
+//     return infof("server", "%s", msg);
 // }
 //
 // void __server_warn(char * msg) {
-//     return warnf("server", msg);
+//     return warnf("server", "%s", msg);
 // }
 //
 // void __server_error(char * msg) {
-//     return errorf("server", msg);
+//     return errorf("server", "%s", msg);
 // }
 //
 import "C"
@@ -36,8 +36,7 @@ import (
 	"os"
 	"os/signal"
 	"os/user"
-	"runtime"
-	"strings"
+	"sync/atomic"
 	"syscall"
 	"time"
 	"unsafe"
@@ -51,21 +50,28 @@ import (
 const (
 	// SizeOfUint64 is the number of bytes to represent a uint64
 	SizeOfUint64 = 8
+	// sampleBatchSize is the maximum number of samples
+	// read from libcarnx at once
+	sampleBatchSize = 64
+	// txPrefix is the prefix of the egress counters in a snapshot
+	txPrefix = "TX_"
 )
 
 var (
 	// nbCounters is the number of available counters
-	nbCounters = int(C.nb_counters())
-	// lookUp is the structure which returns the key given
-	// the name of the counter
-	lookUp = make(map[string]int)
+	nbCounters = len(counterNames)
 	// debug
 	debug = false
+	// stopping is closed when the server shuts down (it
+	// ends the open streams)
+	stopping = make(chan struct{})
+	// sampling is 1 while a Samples stream is open
+	sampling int32
 )
 
 func init() {
 	checkUser()
-	initLookUp()
+	checkSchema()
 }
 
 // ========================================================================== //
@@ -75,16 +81,19 @@ func init() {
 func errorf(format string, a ...interface{}) {
 	msg := C.CString(fmt.Sprintf(format, a...))
 	C.__server_error(msg)
+	C.free(unsafe.Pointer(msg))
 }
 
 func warnf(format string, a ...interface{}) {
 	msg := C.CString(fmt.Sprintf(format, a...))
 	C.__server_warn(msg)
+	C.free(unsafe.Pointer(msg))
 }
 
 func infof(format string, a ...interface{}) {
 	msg := C.CString(fmt.Sprintf(format, a...))
 	C.__server_info(msg)
+	C.free(unsafe.Pointer(msg))
 }
 
 func debugf(format string, a ...interface{}) {
@@ -93,16 +102,16 @@ func debugf(format string, a ...interface{}) {
 	}
 	msg := C.CString(fmt.Sprintf(format, a...))
 	C.__server_debug(msg)
+	C.free(unsafe.Pointer(msg))
 }
 
-func initLookUp() {
-	buffer := C.CString(strings.Repeat("X", 32))
-	for i := 0; i < nbCounters; i++ {
-		C.reverse_lookup(C.int(i), buffer)
-		lookUp[C.GoString(buffer)] = i
+// checkSchema checks that libcarnx has been built from
+// the same counter schema as the daemon (see counters.go)
+func checkSchema() {
+	if hash := uint32(C.schema_hash()); hash != 0 && hash != schemaHash {
+		errorf("Counter schema of libcarnx (%d) differs from the daemon one (%d)", hash, schemaHash)
+		os.Exit(1)
 	}
-	C.free(unsafe.Pointer(buffer))
-	debugf("Counter lookup is done")
 }
 
 // checkUser checks that the program is run by root
@@ -123,19 +132,6 @@ func setDebug() {
 	C.set_debug(1)
 }
 
-// get the name of the current function
-func currentFunction() string {
-	pc := make([]uintptr, 15)
-	n := runtime.Callers(2, pc)
-	frames := runtime.CallersFrames(pc[:n])
-	frame, _ := frames.Next()
-	tree := strings.Split(frame.Function, ".")
-	if len(tree) >= 3 {
-		return tree[2]
-	}
-	return frame.Function
-}
-
 func toUint64Slice(raw []byte) ([]uint64, error) {
 	// create an io.Reader from these bytes
 	buffer := bytes.NewReader(raw)
@@ -174,64 +170,219 @@ type CarnxServer struct{}
 
 // GetNbCounters returns the number of counters
 func (a *CarnxServer) GetNbCounters(ctx context.Context, garbage *api.Garbage) (*api.NbCounters, error) {
-	debugf("Receving call to '%s'")
 	return &api.NbCounters{NbCounters: uint32(nbCounters)}, nil
-
 }
 
 // Ping aims to check the connection
 func (a *CarnxServer) Ping(ctx context.Context, garbage *api.Garbage) (*api.Garbage, error) {
-	debugf("Receiving call to %s", currentFunction())
 	return garbage, nil
 }
 
 // GetCounter returns the value of a counter given its key
 func (a *CarnxServer) GetCounter(ctx context.Context, cid *api.CounterID) (*api.CounterValue, error) {
-	debugf("Receiving call to %s", currentFunction())
 	key := C.int(cid.Id)
-	return &api.CounterValue{Value: uint64(C.get_counter(key))}, nil
+	start := cgoStart()
+	value := uint64(C.get_counter(key))
+	cgoDone(start)
+	return &api.CounterValue{Value: value}, nil
 }
 
 // GetCounterByName returns the value of a counter given its name
 func (a *CarnxServer) GetCounterByName(ctx context.Context, counter *api.CounterName) (*api.CounterValue, error) {
-	debugf("Receiving call to %s", currentFunction())
 	return a.GetCounter(ctx, &api.CounterID{Id: uint32(lookUp[counter.Name])})
 }
 
-// GetCounterNames returns the list of the counters (in the right order)
+// GetSchema returns the metadata of all the counters
+func (a *CarnxServer) GetSchema(ctx context.Context, garbage *api.Garbage) (*api.Schema, error) {
+	counters := make([]*api.CounterInfo, nbCounters)
+	for i, name := range counterNames {
+		info := C.counter_info(C.int(i))
+		counters[i] = &api.CounterInfo{
+			Id:     uint32(i),
+			Name:   name,
+			Group:  uint32(info.feature),
+			Type:   C.GoString(info._type),
+			Unit:   C.GoString(info.unit),
+			Active: bool(C.is_counter_active(C.int(i))),
+		}
+	}
+	return &api.Schema{Hash: schemaHash, Counters: counters}, nil
+}
+
+// GetCounterNames returns the list of the active counters (in the right order)
 func (a *CarnxServer) GetCounterNames(ctx context.Context, garbage *api.Garbage) (*api.CounterList, error) {
-	debugf("Receiving call to %s", currentFunction())
-	names := make([]string, len(lookUp))
-	for n, index := range lookUp {
-		names[index] = n
+	active := make([]string, 0, nbCounters)
+	for index, n := range counterNames {
+		if bool(C.is_counter_active(C.int(index))) {
+			active = append(active, n)
+		}
 	}
-	return &api.CounterList{Counters: names}, nil
+	return &api.CounterList{Counters: active}, nil
 }
 
 // Snapshot returns the current values of the counters
 func (a *CarnxServer) Snapshot(ctx context.Context, garbage *api.Garbage) (*api.Snap, error) {
-	debugf("Receiving call to %s", currentFunction())
 	sec := C.ulong(0)
 	nsec := C.ulong(0)
 
 	values := make([]uint64, nbCounters)
-	// get values
-	C.get_all_counters_with_timestamp((*C.ulong)(&values[0]), &sec, &nsec)
+	txValues := make([]uint64, nbCounters)
+	// get values (both directions at once)
+	start := cgoStart()
+	C.get_rx_tx_counters_with_timestamp((*C.ulong)(&values[0]), (*C.ulong)(&txValues[0]), &sec, &nsec)
+	cgoDone(start)
+	egress := bool(C.is_egress_attached())
 
 	data := make(map[string]uint64)
 	// fill the map
 	data["TIME"] = uint64(time.Unix(int64(sec), int64(nsec)).UnixNano())
 	// (*record)["NSEC"] = uint64(nsec)
-	for name, i := range lookUp {
-		data[name] = values[i]
+	for i, name := range counterNames {
+		if bool(C.is_counter_active(C.int(i))) {
+			data[name] = values[i]
+			if egress {
+				data[txPrefix+name] = txValues[i]
+			}
+		}
 	}
 
 	return &api.Snap{Data: data}, nil
 }
 
+// GetRates returns the packet and bit rates estimated by the
+// kernel program (moving averages over 100 ms buckets)
+func (a *CarnxServer) GetRates(ctx context.Context, garbage *api.Garbage) (*api.Rates, error) {
+	var pps, bps [C.__END_OF_DIRECTIONS__]C.ulong
+
+	start := cgoStart()
+	for dir := 0; dir < int(C.__END_OF_DIRECTIONS__); dir++ {
+		var msg string
+		switch int(C.get_rates(C.int(dir), &pps[dir], &bps[dir])) {
+		case -1:
+			msg = "The program is not loaded"
+		case -2:
+			msg = "Error while reading the rates"
+		case -3:
+			msg = "The rate estimators are not enabled"
+		}
+		if len(msg) > 0 {
+			cgoDone(start)
+			errorf(msg)
+			return nil, fmt.Errorf(msg)
+		}
+	}
+	cgoDone(start)
+
+	return &api.Rates{
+		Time:  uint64(time.Now().UnixNano()),
+		RxPps: uint64(pps[C.DIR_RX]),
+		RxBps: uint64(bps[C.DIR_RX]),
+		TxPps: uint64(pps[C.DIR_TX]),
+		TxBps: uint64(bps[C.DIR_TX]),
+	}, nil
+}
+
+// GetSniTop returns the most seen (hashed) TLS server names. The
+// L7 or SNI counter group must be enabled
+func (a *CarnxServer) GetSniTop(ctx context.Context, attr *api.SniTopParameters) (*api.SniTop, error) {
+	k := int(attr.K)
+	if k == 0 {
+		k = 10
+	}
+	if k > int(C.SNI_TABLE_SIZE) {
+		k = int(C.SNI_TABLE_SIZE)
+	}
+	hashes := make([]uint32, k)
+	counts := make([]uint64, k)
+	start := cgoStart()
+	n := int(C.get_sni_top((*C.uint)(&hashes[0]), (*C.ulong)(&counts[0]), C.int(k)))
+	cgoDone(start)
+	if n < 0 {
+		return nil, fmt.Errorf("Error while reading the SNI table")
+	}
+
+	entries := make([]*api.SniCount, n)
+	for i := 0; i < n; i++ {
+		entries[i] = &api.SniCount{Hash: hashes[i], Count: counts[i]}
+	}
+	return &api.SniTop{Entries: entries}, nil
+}
+
+// Samples turns the packet sampling on and streams the headers
+// of the sampled packets. The sampling is turned off when the
+// stream ends. A single stream can be open at a time
+func (a *CarnxServer) Samples(attr *api.SampleParameters, stream api.Carnx_SamplesServer) error {
+	rate := attr.Rate
+	if rate == 0 {
+		rate = 1000
+	}
+
+	// the sampler has a single rate and a single queue
+	if !atomic.CompareAndSwapInt32(&sampling, 0, 1) {
+		msg := "Another Samples stream is open"
+		errorf(msg)
+		return fmt.Errorf(msg)
+	}
+	defer atomic.StoreInt32(&sampling, 0)
+
+	var msg string
+	switch int(C.set_sample_rate(C.uint(rate))) {
+	case -1:
+		msg = "The program is not loaded"
+	case -2:
+		msg = "Error while setting the sample rate"
+	case -3:
+		msg = "Error while starting the samples consumer"
+	}
+	if len(msg) > 0 {
+		errorf(msg)
+		return fmt.Errorf(msg)
+	}
+	defer C.set_sample_rate(0)
+
+	samples := make([]C.struct_sample, sampleBatchSize)
+	for {
+		select {
+		case <-stream.Context().Done():
+			return nil
+		case <-stopping:
+			return nil
+		default:
+		}
+
+		n := int(C.read_samples(&samples[0], C.int(sampleBatchSize), 100))
+		if n < 0 {
+			// the program has been unloaded
+			return nil
+		}
+		if n == 0 {
+			continue
+		}
+		dropped := uint64(C.get_dropped_samples())
+		for i := 0; i < n; i++ {
+			s := &samples[i]
+			err := stream.Send(&api.Sample{
+				Timestamp: uint64(s.timestamp),
+				Ifindex:   uint32(s.ifindex),
+				Cpu:       uint32(s.cpu),
+				Length:    uint32(s.length),
+				L3Proto:   uint32(s.l3_proto),
+				L4Proto:   uint32(s.l4_proto),
+				Data:      C.GoBytes(unsafe.Pointer(&s.data[0]), C.int(s.cap_len)),
+				Dropped:   dropped,
+			})
+			if err != nil {
+				return err
+			}
+		}
+	}
+}
+
 // Load an eBPF program into the kernel
 func (a *CarnxServer) Load(ctx context.Context, attr *api.LoadParameters) (*api.ReturnCode, error) {
-	ret := int32(C.load(C.CString(attr.BpfProgram)))
+	program := C.CString(attr.BpfProgram)
+	defer C.free(unsafe.Pointer(program))
+	ret := int32(C.load(program, C.uint(attr.Features)))
 	returnCode := api.ReturnCode{Code: ret}
 
 	if ret < 0 {
@@ -244,11 +395,15 @@ func (a *CarnxServer) Load(ctx context.Context, attr *api.LoadParameters) (*api.
 // into the kernel and attach it to the given interface with
 // the flags
 func (a *CarnxServer) LoadAndAttach(ctx context.Context, attr *api.LoadAttachParameters) (*api.ReturnCode, error) {
-	debugf("Receiving call to %s", currentFunction())
 	debugf("Loading %s to interface %s", attr.BpfProgram, attr.Interface)
-	ret := int32(C.load_and_attach(C.CString(attr.BpfProgram),
-		C.CString(attr.Interface),
-		C.uint(attr.XdpFlags)))
+	program := C.CString(attr.BpfProgram)
+	defer C.free(unsafe.Pointer(program))
+	iface := C.CString(attr.Interface)
+	defer C.free(unsafe.Pointer(iface))
+	ret := int32(C.load_and_attach(program,
+		iface,
+		C.uint(attr.XdpFlags),
+		C.uint(attr.Features)))
 
 	returnCode := api.ReturnCode{Code: ret}
 	// check errors
@@ -265,6 +420,10 @@ func (a *CarnxServer) LoadAndAttach(ctx context.Context, attr *api.LoadAttachPar
 		msg := "Error while attaching program"
 		errorf(msg)
 		return &returnCode, fmt.Errorf(msg)
+	case -4:
+		msg := "Another XDP program is attached to the interface (use chain)"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
 	default:
 		infof("Program loaded and attached to %s", attr.Interface)
 		// startMonitoring()
@@ -272,9 +431,83 @@ func (a *CarnxServer) LoadAndAttach(ctx context.Context, attr *api.LoadAttachPar
 	}
 }
 
+// Upgrade replaces the running eBPF program by a new one. The counters
+// are kept and the program is swapped atomically on the interface
+func (a *CarnxServer) Upgrade(ctx context.Context, attr *api.UpgradeParameters) (*api.ReturnCode, error) {
+	debugf("Upgrading to %s", attr.BpfProgram)
+	program := C.CString(attr.BpfProgram)
+	defer C.free(unsafe.Pointer(program))
+	ret := int32(C.upgrade(program, C.uint(attr.Features)))
+
+	returnCode := api.ReturnCode{Code: ret}
+	// check errors
+	switch ret {
+	case -1:
+		msg := "Error while loading BPF program"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	case -2:
+		msg := "Error while retrieving the file descriptor of the map"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	case -3:
+		msg := "Error while replacing program"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	case -4:
+		msg := "The BPF program is not loaded"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	default:
+		infof("Program upgraded to %s", attr.BpfProgram)
+		return &returnCode, nil
+	}
+}
+
+// PlugStage replaces a single stage of the parser pipeline
+// without detaching the program
+func (a *CarnxServer) PlugStage(ctx context.Context, attr *api.StageParameters) (*api.ReturnCode, error) {
+	debugf("Plugging %s as stage %d", attr.BpfProgram, attr.Stage)
+	program := C.CString(attr.BpfProgram)
+	defer C.free(unsafe.Pointer(program))
+	ret := int32(C.plug_stage(C.int(attr.Stage), program))
+
+	returnCode := api.ReturnCode{Code: ret}
+	// check errors
+	switch ret {
+	case -1:
+		msg := "Error while loading the stage"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	case -2:
+		msg := "Error while setting the stage"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	case -4:
+		msg := "The BPF program is not loaded"
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	default:
+		infof("Stage %d plugged from %s", attr.Stage, attr.BpfProgram)
+		return &returnCode, nil
+	}
+}
+
+// UnplugStage removes a stage plugged at runtime and restores
+// the built-in one
+func (a *CarnxServer) UnplugStage(ctx context.Context, attr *api.StageID) (*api.ReturnCode, error) {
+	ret := int32(C.unplug_stage(C.int(attr.Stage)))
+
+	returnCode := api.ReturnCode{Code: ret}
+	if ret < 0 {
+		return &returnCode, fmt.Errorf("Error while unplugging stage %d", attr.Stage)
+	}
+	infof("Stage %d unplugged", attr.Stage)
+	return &returnCode, nil
+}
+
 // Unload the eBPF program from the kernel
 func (a *CarnxServer) Unload(ctx context.Context, g *api.Garbage) (*api.ReturnCode, error) {
-	debugf("Receiving call to %s", currentFunction())
 	ret := int32(C.unload())
 
 	returnCode := api.ReturnCode{Code: ret}
@@ -287,13 +520,27 @@ func (a *CarnxServer) Unload(ctx context.Context, g *api.Garbage) (*api.ReturnCo
 
 // Attach the XDP program onto the given interface
 func (a *CarnxServer) Attach(ctx context.Context, attr *api.AttachParameters) (*api.ReturnCode, error) {
-	debugf("Receiving call to %s", currentFunction())
 	debugf("Attaching to %s", attr.Interface)
-	ret := int32(C.attach(C.CString(attr.Interface), C.uint(attr.XdpFlags)))
+	if attr.Chain {
+		return a.attachChained(attr)
+	}
+	iface := C.CString(attr.Interface)
+	defer C.free(unsafe.Pointer(iface))
+	ret := int32(C.attach(iface, C.uint(attr.XdpFlags)))
 
 	returnCode := api.ReturnCode{Code: int32(ret)}
-	if ret < 0 {
-		return &returnCode, fmt.Errorf("The BPF program is not loaded")
+	var msg string
+	switch ret {
+	case -1:
+		msg = "The BPF program is not loaded"
+	case -2:
+		msg = "Another XDP program is attached to the interface (use chain)"
+	case -3:
+		msg = "Error while attaching program"
+	}
+	if len(msg) > 0 {
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
 	}
 	infof("Program is attached to %s", attr.Interface)
 	// start prometheus
@@ -301,9 +548,65 @@ func (a *CarnxServer) Attach(ctx context.Context, attr *api.AttachParameters) (*
 	return &returnCode, nil
 }
 
-// Detach the XDP program from the interface previously given
+// attachChained attaches the XDP program in front of the
+// program already attached to the interface
+func (a *CarnxServer) attachChained(attr *api.AttachParameters) (*api.ReturnCode, error) {
+	iface := C.CString(attr.Interface)
+	defer C.free(unsafe.Pointer(iface))
+	ret := int32(C.attach_chained(iface, C.uint(attr.XdpFlags)))
+
+	returnCode := api.ReturnCode{Code: ret}
+	var msg string
+	switch ret {
+	case -1:
+		msg = "The BPF program is not loaded"
+	case -2:
+		msg = "Error while querying the program of the interface"
+	case -3:
+		msg = "Error while chaining the program of the interface"
+	case -4:
+		msg = "Error while replacing the program of the interface"
+	}
+	if len(msg) > 0 {
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	}
+	infof("Program is attached to %s (chained: %v)", attr.Interface, bool(C.is_chained()))
+	return &returnCode, nil
+}
+
+// MeasureChainHop runs a test instance of the program with and
+// without a chained program to measure the cost of the hop
+func (a *CarnxServer) MeasureChainHop(ctx context.Context, attr *api.HopParameters) (*api.HopCost, error) {
+	repeat := attr.Repeat
+	if repeat == 0 {
+		repeat = 100000
+	}
+	alone := C.uint(0)
+	chained := C.uint(0)
+	program := C.CString(attr.BpfProgram)
+	defer C.free(unsafe.Pointer(program))
+	ret := int(C.measure_chain_hop(program, C.uint(attr.Features), C.int(repeat), &alone, &chained))
+
+	var msg string
+	switch ret {
+	case -1:
+		msg = "Error while loading BPF program"
+	case -2:
+		msg = "The BPF program has no no-op program"
+	case -3:
+		msg = "Error while running the BPF program"
+	}
+	if len(msg) > 0 {
+		errorf(msg)
+		return nil, fmt.Errorf(msg)
+	}
+	return &api.HopCost{Alone: uint32(alone), Chained: uint32(chained)}, nil
+}
+
+// Detach the XDP program from the interface previously given. In
+// chaining mode, the program which was attached before is put back
 func (a *CarnxServer) Detach(ctx context.Context, g *api.Garbage) (*api.ReturnCode, error) {
-	debugf("Receiving call to %s", currentFunction())
 	iface := getIface()
 	debugf("Detaching from %s", iface)
 	ret := int32(C.detach())
@@ -320,14 +623,52 @@ func (a *CarnxServer) Detach(ctx context.Context, g *api.Garbage) (*api.ReturnCo
 
 // IsLoaded check if the program is loaded into the kernel
 func (a *CarnxServer) IsLoaded(ctx context.Context, g *api.Garbage) (*api.LoadStatus, error) {
-	debugf("Receiving call to %s", currentFunction())
 	return &api.LoadStatus{Loaded: bool(C.is_loaded())}, nil
 }
 
+// AttachEgress counts the outgoing packets of the interface
+// too (TC egress hook). The XDP program must be attached
+func (a *CarnxServer) AttachEgress(ctx context.Context, g *api.Garbage) (*api.ReturnCode, error) {
+	ret := int32(C.attach_egress())
+
+	returnCode := api.ReturnCode{Code: ret}
+	var msg string
+	switch ret {
+	case -1:
+		msg = "The BPF program is not attached"
+	case -2:
+		msg = "The BPF program has no egress counterpart"
+	case -3:
+		msg = "Error while attaching the egress program"
+	}
+	if len(msg) > 0 {
+		errorf(msg)
+		return &returnCode, fmt.Errorf(msg)
+	}
+	infof("Egress program is attached to %s", getIface())
+	return &returnCode, nil
+}
+
+// DetachEgress stops counting the outgoing packets
+func (a *CarnxServer) DetachEgress(ctx context.Context, g *api.Garbage) (*api.ReturnCode, error) {
+	ret := int32(C.detach_egress())
+
+	returnCode := api.ReturnCode{Code: ret}
+	if ret < 0 {
+		return &returnCode, fmt.Errorf("Error while detaching the egress program")
+	}
+	infof("Egress program detached from %s", getIface())
+	return &returnCode, nil
+}
+
+// IsEgressAttached check if the outgoing packets are counted
+func (a *CarnxServer) IsEgressAttached(ctx context.Context, g *api.Garbage) (*api.AttachStatus, error) {
+	return &api.AttachStatus{Attached: bool(C.is_egress_attached())}, nil
+}
+
 // IsAttached check if the program is attached to the interface
 func (a *CarnxServer) IsAttached(ctx context.Context, g *api.Garbage) (*api.AttachStatus, error) {
-	debugf("Receiving call to %s", currentFunction())
-	return &api.AttachStatus{Attached: bool(C.is_attached())}, nil
+	return &api.AttachStatus{Attached: bool(C.is_attached()), Chained: bool(C.is_chained())}, nil
 }
 
 // ========================================================================== //
@@ -341,8 +682,9 @@ func ServeGRPC(unixPath string) error {
 		errorf("Failed to listen: %v", err)
 		return err
 	}
-	grpcServer := grpc.NewServer()
+	grpcServer := grpc.NewServer(serverOptions()...)
 	api.RegisterCarnxServer(grpcServer, &CarnxServer{})
+	initStats(grpcServer)
 	// determine whether to use TLS
 	infof("Listening on %s", unixPath)
 	return grpcServer.Serve(lis)
@@ -366,9 +708,10 @@ func serve(l net.Listener) error {
 	// attend 5 secondes la fin des connexions en cours.
 	done := make(chan struct{})
 	quit := make(chan os.Signal, 1)
-	server := grpc.NewServer()
+	server := grpc.NewServer(serverOptions()...)
 	s := &CarnxServer{}
 	api.RegisterCarnxServer(server, s)
+	initStats(server)
 	reflection.Register(server)
 	signal.Notify(quit, syscall.SIGINT, syscall.SIGTERM)
 
@@ -376,6 +719,8 @@ func serve(l net.Listener) error {
 		<-quit
 		fmt.Println("")
 		infof("Server is shutting down")
+		close(stopping)
+		stopFederation()
 		server.GracefulStop()
 		clean(s)
 		close(done)
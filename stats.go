@@ -0,0 +1,179 @@
+// stats.go
+//
+
+package main
+
+// #include "user.h"
+import "C"
+
+import (
+	"carnx/api"
+	"context"
+	"math/bits"
+	"runtime"
+	"sort"
+	"strings"
+	"sync/atomic"
+	"time"
+
+	"google.golang.org/grpc"
+)
+
+const (
+	// nbLatencyBuckets is the number of buckets of the latency
+	// histograms. Bucket i counts the calls which lasted less
+	// than 2^i µs (the last one counts all the others)
+	nbLatencyBuckets = 24
+)
+
+// rpcStats gathers the measures of a single RPC. All the
+// fields are updated atomically
+type rpcStats struct {
+	calls   uint64
+	errors  uint64
+	totalNs uint64
+	latency [nbLatencyBuckets]uint64
+}
+
+// serverStats gathers the measures of the daemon. The rpcs map is
+// filled once before serving (then only read), so the hot path
+// does not take any lock
+type serverStats struct {
+	enabled bool
+	start   time.Time
+	rpcs    map[string]*rpcStats
+	cgoCall uint64
+	cgoNs   uint64
+}
+
+var (
+	// stats is the instrumentation layer (disabled by default)
+	stats = serverStats{rpcs: make(map[string]*rpcStats)}
+)
+
+// setStats enables the instrumentation layer
+func setStats() {
+	stats.enabled = true
+	stats.start = time.Now()
+}
+
+// initStats creates the entries of all the RPCs of
+// the server (it must be called before serving)
+func initStats(server *grpc.Server) {
+	for service, info := range server.GetServiceInfo() {
+		for _, m := range info.Methods {
+			stats.rpcs["/"+service+"/"+m.Name] = &rpcStats{}
+		}
+	}
+}
+
+// observe records a call of the RPC
+func (s *rpcStats) observe(start time.Time, err error) {
+	ns := uint64(time.Since(start).Nanoseconds())
+	bucket := bits.Len64(ns / 1000)
+	if bucket >= nbLatencyBuckets {
+		bucket = nbLatencyBuckets - 1
+	}
+	atomic.AddUint64(&s.calls, 1)
+	atomic.AddUint64(&s.totalNs, ns)
+	atomic.AddUint64(&s.latency[bucket], 1)
+	if err != nil {
+		atomic.AddUint64(&s.errors, 1)
+	}
+}
+
+// cgoStart returns the time before a call to libcarnx
+// (zero when the instrumentation is disabled)
+func cgoStart() time.Time {
+	if !stats.enabled {
+		return time.Time{}
+	}
+	return time.Now()
+}
+
+// cgoDone records a call to libcarnx started at start
+func cgoDone(start time.Time) {
+	if start.IsZero() {
+		return
+	}
+	atomic.AddUint64(&stats.cgoCall, 1)
+	atomic.AddUint64(&stats.cgoNs, uint64(time.Since(start).Nanoseconds()))
+}
+
+// unaryInterceptor logs (debug) and measures the unary RPCs
+func unaryInterceptor(ctx context.Context, req interface{}, info *grpc.UnaryServerInfo, handler grpc.UnaryHandler) (interface{}, error) {
+	debugf("Receiving call to %s", info.FullMethod)
+	if !stats.enabled {
+		return handler(ctx, req)
+	}
+	start := time.Now()
+	resp, err := handler(ctx, req)
+	if s, exists := stats.rpcs[info.FullMethod]; exists {
+		s.observe(start, err)
+	}
+	return resp, err
+}
+
+// streamInterceptor logs (debug) and measures the streaming
+// RPCs (the latency is the lifetime of the stream)
+func streamInterceptor(srv interface{}, ss grpc.ServerStream, info *grpc.StreamServerInfo, handler grpc.StreamHandler) error {
+	debugf("Receiving call to %s", info.FullMethod)
+	if !stats.enabled {
+		return handler(srv, ss)
+	}
+	start := time.Now()
+	err := handler(srv, ss)
+	if s, exists := stats.rpcs[info.FullMethod]; exists {
+		s.observe(start, err)
+	}
+	return err
+}
+
+// serverOptions returns the interceptors to install. None is
+// installed when neither debug nor stats are enabled, so that
+// the RPCs do not pay for them
+func serverOptions() []grpc.ServerOption {
+	if !debug && !stats.enabled {
+		return nil
+	}
+	return []grpc.ServerOption{
+		grpc.UnaryInterceptor(unaryInterceptor),
+		grpc.StreamInterceptor(streamInterceptor),
+	}
+}
+
+// GetStats returns the internal measures of the daemon
+func (a *CarnxServer) GetStats(ctx context.Context, g *api.Garbage) (*api.Stats, error) {
+	var mem runtime.MemStats
+	runtime.ReadMemStats(&mem)
+
+	out := &api.Stats{
+		Enabled:       stats.enabled,
+		CgoCalls:      atomic.LoadUint64(&stats.cgoCall),
+		CgoNs:         atomic.LoadUint64(&stats.cgoNs),
+		MapReadErrors: uint64(C.get_map_read_errors()),
+		Mallocs:       mem.Mallocs,
+		Frees:         mem.Frees,
+		HeapAlloc:     mem.HeapAlloc,
+		NumGc:         uint64(mem.NumGC),
+	}
+	if stats.enabled {
+		out.UptimeNs = uint64(time.Since(stats.start).Nanoseconds())
+	}
+
+	for method, s := range stats.rpcs {
+		latency := make([]uint64, nbLatencyBuckets)
+		for i := range latency {
+			latency[i] = atomic.LoadUint64(&s.latency[i])
+		}
+		out.Rpcs = append(out.Rpcs, &api.RpcStats{
+			Method:  method[strings.LastIndex(method, "/")+1:],
+			Calls:   atomic.LoadUint64(&s.calls),
+			Errors:  atomic.LoadUint64(&s.errors),
+			TotalNs: atomic.LoadUint64(&s.totalNs),
+			Latency: latency,
+		})
+	}
+	sort.Slice(out.Rpcs, func(i, j int) bool { return out.Rpcs[i].Method < out.Rpcs[j].Method })
+	return out, nil
+}
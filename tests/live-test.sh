@@ -34,6 +34,10 @@ test="${GRPCURL} ${GRPCURL_FLAGS}"
 title "Getting the number of counters"
 ${test} ${GRPCURL_ADDR} "api.Carnx/GetNbCounters"
 
+title "Getting the counter schema"
+n="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetSchema" | jq ".counters | length")"
+result "${n}" "$(${test} ${GRPCURL_ADDR} "api.Carnx/GetNbCounters" | jq ".nbCounters")"
+
 title "Getting counter names"
 ${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterNames"
 
@@ -59,6 +63,15 @@ done
 title "Performing a snapshot"
 ${test} ${GRPCURL_ADDR} "api.Carnx/Snapshot"
 
+title "Upgrading in place"
+before="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterByName" -d '{"name":"PKT"}' | jq -r ".value")"
+${test} -d '{"bpf_program": "./bin/carnx.bpf"}' ${GRPCURL_ADDR} "api.Carnx/Upgrade"
+after="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterByName" -d '{"name":"PKT"}' | jq -r ".value")"
+result "$((after >= before))" "1"
+
+attached="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsAttached" | jq ".attached")"
+result "${attached}" "true"
+
 title "Detaching"
 ${test} ${GRPCURL_ADDR} "api.Carnx/Detach"
 
@@ -71,6 +84,39 @@ ${test} -d '{"interface": "lo", "xdp_flags": 0}' ${GRPCURL_ADDR} "api.Carnx/Atta
 attached="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsAttached" | jq ".attached")"
 result "${attached}" "true"
 
+title "Chaining mode (no other program on 'lo')"
+${test} ${GRPCURL_ADDR} "api.Carnx/Detach"
+${test} -d '{"interface": "lo", "xdp_flags": 0, "chain": true}' ${GRPCURL_ADDR} "api.Carnx/Attach"
+
+status="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsAttached" | jq -c ".")"
+result "${status}" '{"attached":true,"chained":false}'
+
+title "Measuring the chaining hop"
+cost="$(${test} -d '{"bpf_program": "./bin/carnx.bpf", "repeat": 100000}' ${GRPCURL_ADDR} "api.Carnx/MeasureChainHop")"
+echo "${cost}"
+result "$(echo "${cost}" | jq ".alone > 0")" "true"
+
+title "Chaining mode (in front of another program on 'lo')"
+${test} ${GRPCURL_ADDR} "api.Carnx/Detach"
+ip link set dev lo xdpgeneric obj ./bin/carnx.bpf sec xdp/pass
+${test} -d '{"interface": "lo", "xdp_flags": 2, "chain": true}' ${GRPCURL_ADDR} "api.Carnx/Attach"
+
+status="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsAttached" | jq -c ".")"
+result "${status}" '{"attached":true,"chained":true}'
+
+# the packets are counted, then handed to the previous program
+before="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterByName" -d '{"name":"PKT"}' | jq -r ".value")"
+ping -c 5 -i 0.2 127.0.0.1 >/dev/null
+result "$?" "0"
+after="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterByName" -d '{"name":"PKT"}' | jq -r ".value")"
+result "$((after > before))" "1"
+
+# detaching puts the previous program back
+${test} ${GRPCURL_ADDR} "api.Carnx/Detach"
+prog="$(ip -d -j link show dev lo | jq -r ".[0].xdp.prog.name")"
+result "${prog}" "xdp_pass"
+ip link set dev lo xdpgeneric off
+
 title "Detaching and unloading"
 ${test} ${GRPCURL_ADDR} "api.Carnx/Detach"
 
@@ -88,6 +134,112 @@ ${test} -d '{"interface": "lo", "xdp_flags": 0, "bpf_program": "./bin/carnx.bpf"
 loaded="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsLoaded" | jq ".loaded")"
 result "${loaded}" "true"
 
+title "Plugging a stage at runtime"
+${test} -d '{"stage": 0, "bpf_program": "./bin/carnx.bpf"}' ${GRPCURL_ADDR} "api.Carnx/PlugStage"
+
+attached="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsAttached" | jq ".attached")"
+result "${attached}" "true"
+
+${test} -d '{"stage": 0}' ${GRPCURL_ADDR} "api.Carnx/UnplugStage"
+
+title "Upgrading to a PKT-only program"
+${test} -d '{"bpf_program": "./bin/carnx.bpf", "features": 1}' ${GRPCURL_ADDR} "api.Carnx/Upgrade"
+
+names="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterNames" | jq -c ".counters")"
+result "${names}" '["PKT"]'
+
+title "Upgrading to a program with app-layer counters"
+${test} -d '{"bpf_program": "./bin/carnx.bpf", "features": 63}' ${GRPCURL_ADDR} "api.Carnx/Upgrade"
+
+n="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterNames" | jq ".counters | length")"
+result "${n}" "$(${test} ${GRPCURL_ADDR} "api.Carnx/GetNbCounters" | jq ".nbCounters")"
+
+${test} -d '{"k": 5}' ${GRPCURL_ADDR} "api.Carnx/GetSniTop"
+
+title "Counting DNS queries (PKT and app-layer groups only)"
+${test} -d '{"bpf_program": "./bin/carnx.bpf", "features": 17}' ${GRPCURL_ADDR} "api.Carnx/Upgrade"
+# no server is needed: the query is counted when it goes through 'lo'
+dig @127.0.0.1 +tries=1 +time=1 carnx.test >/dev/null
+dns="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetCounterByName" -d '{"name":"DNS_QUERY"}' | jq -r ".value")"
+result "$((dns > 0))" "1"
+
+${test} -d '{"bpf_program": "./bin/carnx.bpf"}' ${GRPCURL_ADDR} "api.Carnx/Upgrade"
+
+title "Counting egress packets"
+${test} ${GRPCURL_ADDR} "api.Carnx/AttachEgress"
+attached="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsEgressAttached" | jq ".attached")"
+result "${attached}" "true"
+
+sleep 1
+tx="$(${test} ${GRPCURL_ADDR} "api.Carnx/Snapshot" | jq '.data.TX_PKT | tonumber')"
+result "$((tx > 0))" "1"
+
+${test} ${GRPCURL_ADDR} "api.Carnx/DetachEgress"
+attached="$(${test} ${GRPCURL_ADDR} "api.Carnx/IsEgressAttached" | jq ".attached")"
+result "${attached}" "false"
+
+title "Sampling packets"
+samples="$(timeout 3 ${test} -d '{"rate": 1}' ${GRPCURL_ADDR} "api.Carnx/Samples" | jq -s "length")"
+result "$((samples > 0))" "1"
+
+title "Estimating rates"
+ping -f -c 1000 127.0.0.1 >/dev/null
+${test} ${GRPCURL_ADDR} "api.Carnx/GetRates"
+pps="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetRates" | jq -r ".rxPps")"
+result "$((pps > 0))" "1"
+
+# the rate falls once the flood stops...
+sleep 2
+idle="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetRates" | jq -r ".rxPps")"
+result "$((idle < pps))" "1"
+# ...and a single packet does not bring it back (the kernel
+# decays the idle buckets like GetRates does)
+ping -c 1 127.0.0.1 >/dev/null
+after="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetRates" | jq -r ".rxPps")"
+result "$((after <= idle + 10))" "1"
+
+title "Internal stats"
+stats="$(${test} ${GRPCURL_ADDR} "api.Carnx/GetStats")"
+result "$(echo "${stats}" | jq ".rpcs | length > 0")" "true"
+result "$(echo "${stats}" | jq -r ".mapReadErrors")" "0"
+
+title "Aggregating several daemons"
+AGG_ADDR="/tmp/carnx-agg.sock"
+IDLE_ADDR="/tmp/carnx-idle.sock"
+# an idle daemon (nothing loaded) is reported as down
+./bin/carnxd --unix "${IDLE_ADDR}" &
+idle_pid=$!
+./bin/carnxd --unix "${AGG_ADDR}" --upstream "main=${GRPCURL_ADDR}" --upstream "idle=${IDLE_ADDR}" &
+agg_pid=$!
+sleep 2
+
+merged="$(${test} ${AGG_ADDR} "api.Carnx/MergedSnapshot")"
+result "$(echo "${merged}" | jq -c "[.sources[] | {source, up}]")" '[{"source":"main","up":true},{"source":"idle","up":false}]'
+result "$(echo "${merged}" | jq '.total.PKT | tonumber > 0')" "true"
+
+# loading a program brings the idle daemon up (after the backoff)
+${test} -d '{"bpf_program": "./bin/carnx.bpf"}' ${IDLE_ADDR} "api.Carnx/Load"
+sleep 5
+up="$(${test} ${AGG_ADDR} "api.Carnx/MergedSnapshot" | jq ".sources[1].up")"
+result "${up}" "true"
+
+# a hanging upstream (its socket stays open) is reported as down
+# (its last snapshot is still summed)
+kill -STOP ${idle_pid}
+sleep 4
+merged="$(${test} ${AGG_ADDR} "api.Carnx/MergedSnapshot")"
+result "$(echo "${merged}" | jq -c ".sources[1] | {up, stale}")" '{"up":false,"stale":true}'
+result "$(echo "${merged}" | jq '(.total.PKT | tonumber) >= (.sources[1].data.PKT | tonumber)')" "true"
+kill -CONT ${idle_pid}
+
+# the merge does not depend on the upstreams
+kill -INT ${idle_pid}
+updates="$(timeout 3 ${test} -d '{"period_ms": 500}' ${AGG_ADDR} "api.Carnx/MergedSnapshotStream" | jq -s "length")"
+result "$((updates > 0))" "1"
+
+kill -INT ${agg_pid}
+wait ${idle_pid} ${agg_pid}
+
 title "Final snapshots"
 for ((i = 0; i <= 5; i++)); do
     ${test} ${GRPCURL_ADDR} "api.Carnx/Snapshot"